@@ -0,0 +1,151 @@
+
+namespace encodeuzk {
+
+template<typename BaseDefs>
+class ArenaFormula;
+
+template<typename BaseDefs>
+class ArenaAllocator;
+
+template<typename BaseDefs>
+class ArenaEmitter;
+
+// a sequence of elements that is stored in fixed-size chunks. the sequence
+// continues across chunk boundaries. elements are never relocated,
+// so growing the storage never needs more memory than the data itself.
+// if ENCODEUZK_ARENA_MMAP is defined the chunks can be backed by a
+// temporary file; completed chunks are then released from memory
+template<typename T>
+class ArenaChunks {
+public:
+	ArenaChunks(size_t chunk_size);
+	ArenaChunks(const ArenaChunks<T> &other) = delete;
+	ArenaChunks<T> &operator= (const ArenaChunks<T> &other) = delete;
+	~ArenaChunks();
+
+#ifdef ENCODEUZK_ARENA_MMAP
+	// must be called before the first push()
+	void spillTo(const char *directory);
+#endif
+
+	size_t chunkSize() const {
+		return p_chunkSize;
+	}
+
+	uint64_t size() const {
+		return p_chunks.empty() ? 0
+				: (uint64_t)(p_chunks.size() - 1) * p_chunkSize + p_fill;
+	}
+
+	void push(const T &value) {
+		if(p_fill == p_chunkSize)
+			nextChunk();
+		p_chunks.back()[p_fill++] = value;
+	}
+
+	const T &operator[] (uint64_t position) const {
+		return p_chunks[position / p_chunkSize][position % p_chunkSize];
+	}
+
+private:
+	void nextChunk();
+	void completeChunk(T *chunk);
+
+	size_t p_chunkSize;
+	size_t p_fill;
+	std::vector<T *> p_chunks;
+	int p_spillFd;
+};
+
+template<typename BaseDefs>
+struct ArenaDefs {
+	typedef StaticVariable<BaseDefs> Variable;
+	typedef StaticLiteral<BaseDefs> Literal;
+	typedef ArenaAllocator<BaseDefs> VarAllocator;
+	typedef ArenaEmitter<BaseDefs> ClauseEmitter;
+};
+
+template<typename BaseDefs>
+class ArenaAllocator {
+public:
+	typedef ArenaDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+
+	ArenaAllocator(ArenaFormula<BaseDefs> &formula);
+
+	Variable allocate();
+	VariableRange<Variable> allocateRange(size_t n);
+
+private:
+	ArenaFormula<BaseDefs> &p_formula;
+};
+
+template<typename BaseDefs>
+class ArenaEmitter {
+public:
+	typedef ArenaDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+
+	ArenaEmitter(ArenaFormula<BaseDefs> &formula);
+
+	template<typename Iterator>
+	void emit(Iterator begin, Iterator end);
+	void emitBlock(const Literal *literals, const unsigned int *sizes, size_t num_clauses);
+private:
+	ArenaFormula<BaseDefs> &p_formula;
+};
+
+template<typename BaseDefs>
+std::ostream &operator<< (std::ostream &stream, const ArenaFormula<BaseDefs> &formula);
+
+// clause store for very large formulas. the literal indices of all clauses
+// are stored back to back; the position where each clause ends
+// provides random access to the clauses
+template<typename BaseDefs>
+class ArenaFormula {
+public:
+	typedef ArenaDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+	typedef typename Defs::VarAllocator VarAllocator;
+	typedef typename Defs::ClauseEmitter ClauseEmitter;
+
+	friend class ArenaAllocator<BaseDefs>;
+	friend class ArenaEmitter<BaseDefs>;
+	friend std::ostream &operator<< <> (std::ostream &stream, const ArenaFormula<BaseDefs> &formula);
+
+	ArenaFormula(size_t chunk_size = 1 << 20);
+
+#ifdef ENCODEUZK_ARENA_MMAP
+	void spillTo(const char *directory);
+#endif
+
+	uint64_t numVariables() const {
+		return p_numVariables;
+	}
+	uint64_t numClauses() const {
+		return p_numClauses;
+	}
+
+	size_t clauseSize(uint64_t clause) const {
+		return p_ends[clause] - clauseBegin(clause);
+	}
+	Literal clauseLiteral(uint64_t clause, size_t k) const {
+		return Literal::fromIndex(p_literals[clauseBegin(clause) + k]);
+	}
+
+private:
+	uint64_t clauseBegin(uint64_t clause) const {
+		return clause == 0 ? 0 : p_ends[clause - 1];
+	}
+
+	uint64_t p_numVariables;
+	uint64_t p_numClauses;
+	ArenaChunks<typename BaseDefs::LiteralIndex> p_literals;
+	ArenaChunks<uint64_t> p_ends;
+};
+
+}; // namespace encodeuzk
+
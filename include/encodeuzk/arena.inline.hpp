@@ -0,0 +1,139 @@
+
+namespace encodeuzk {
+
+template<typename T>
+ArenaChunks<T>::ArenaChunks(size_t chunk_size)
+		: p_chunkSize(chunk_size), p_fill(chunk_size), p_spillFd(-1) { }
+
+template<typename T>
+ArenaChunks<T>::~ArenaChunks() {
+#ifdef ENCODEUZK_ARENA_MMAP
+	if(p_spillFd >= 0) {
+		for(auto it = p_chunks.begin(); it != p_chunks.end(); ++it)
+			munmap(*it, p_chunkSize * sizeof(T));
+		close(p_spillFd);
+		return;
+	}
+#endif
+	for(auto it = p_chunks.begin(); it != p_chunks.end(); ++it)
+		delete[] *it;
+}
+
+#ifdef ENCODEUZK_ARENA_MMAP
+template<typename T>
+void ArenaChunks<T>::spillTo(const char *directory) {
+	assert(p_chunks.empty());
+	assert((p_chunkSize * sizeof(T)) % sysconf(_SC_PAGESIZE) == 0);
+
+	std::string path = std::string(directory) + "/encodeuzk-XXXXXX";
+	std::vector<char> buffer(path.begin(), path.end());
+	buffer.push_back(0);
+	p_spillFd = mkstemp(buffer.data());
+	if(p_spillFd < 0)
+		throw std::runtime_error("Could not create spill file");
+	// the file is removed as soon as it is closed
+	unlink(buffer.data());
+}
+#endif
+
+template<typename T>
+void ArenaChunks<T>::nextChunk() {
+	if(!p_chunks.empty())
+		completeChunk(p_chunks.back());
+	p_fill = 0;
+#ifdef ENCODEUZK_ARENA_MMAP
+	if(p_spillFd >= 0) {
+		size_t bytes = p_chunkSize * sizeof(T);
+		off_t offset = (off_t)p_chunks.size() * bytes;
+		if(ftruncate(p_spillFd, offset + bytes) != 0)
+			throw std::runtime_error("Could not grow spill file");
+		void *chunk = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+				MAP_SHARED, p_spillFd, offset);
+		if(chunk == MAP_FAILED)
+			throw std::runtime_error("Could not map spill file");
+		p_chunks.push_back(static_cast<T *>(chunk));
+		return;
+	}
+#endif
+	p_chunks.push_back(new T[p_chunkSize]);
+}
+
+template<typename T>
+void ArenaChunks<T>::completeChunk(T *chunk) {
+#ifdef ENCODEUZK_ARENA_MMAP
+	// the data stays in the page cache and is written back to the file;
+	// it is read again on the next access
+	if(p_spillFd >= 0)
+		madvise(chunk, p_chunkSize * sizeof(T), MADV_DONTNEED);
+#endif
+}
+
+template<typename BaseDefs>
+ArenaAllocator<BaseDefs>::ArenaAllocator(ArenaFormula<BaseDefs> &formula)
+		: p_formula(formula) { }
+
+template<typename BaseDefs>
+typename ArenaDefs<BaseDefs>::Variable ArenaAllocator<BaseDefs>::allocate() {
+	p_formula.p_numVariables++;
+	return Variable::fromNumber(p_formula.p_numVariables);
+}
+
+template<typename BaseDefs>
+VariableRange<typename ArenaDefs<BaseDefs>::Variable>
+ArenaAllocator<BaseDefs>::allocateRange(size_t n) {
+	Variable first = Variable::fromNumber(p_formula.p_numVariables + 1);
+	p_formula.p_numVariables += n;
+	return VariableRange<Variable>(first, n);
+}
+
+template<typename BaseDefs>
+ArenaEmitter<BaseDefs>::ArenaEmitter(ArenaFormula<BaseDefs> &formula)
+		: p_formula(formula) { }
+
+template<typename BaseDefs>
+template<typename Iterator>
+void ArenaEmitter<BaseDefs>::emit(Iterator begin, Iterator end) {
+	for(auto it = begin; it != end; ++it)
+		p_formula.p_literals.push(it->getIndex());
+	p_formula.p_ends.push(p_formula.p_literals.size());
+	p_formula.p_numClauses++;
+}
+
+template<typename BaseDefs>
+void ArenaEmitter<BaseDefs>::emitBlock(const Literal *literals,
+		const unsigned int *sizes, size_t num_clauses) {
+	for(size_t i = 0; i < num_clauses; i++) {
+		for(unsigned int k = 0; k < sizes[i]; k++)
+			p_formula.p_literals.push((literals++)->getIndex());
+		p_formula.p_ends.push(p_formula.p_literals.size());
+	}
+	p_formula.p_numClauses += num_clauses;
+}
+
+template<typename BaseDefs>
+std::ostream &operator<< (std::ostream &stream, const ArenaFormula<BaseDefs> &formula) {
+	stream << "p cnf " << formula.p_numVariables << " " << formula.p_numClauses << std::endl;
+	for(uint64_t i = 0; i < formula.p_numClauses; i++) {
+		size_t length = formula.clauseSize(i);
+		for(size_t k = 0; k < length; k++)
+			stream << formula.clauseLiteral(i, k).toNumber() << ' ';
+		stream << '0' << std::endl;
+	}
+	return stream;
+}
+
+template<typename BaseDefs>
+ArenaFormula<BaseDefs>::ArenaFormula(size_t chunk_size)
+		: p_numVariables(0), p_numClauses(0),
+		p_literals(chunk_size), p_ends(chunk_size) { }
+
+#ifdef ENCODEUZK_ARENA_MMAP
+template<typename BaseDefs>
+void ArenaFormula<BaseDefs>::spillTo(const char *directory) {
+	p_literals.spillTo(directory);
+	p_ends.spillTo(directory);
+}
+#endif
+
+} // namespace encodeuzk
+
@@ -39,9 +39,13 @@ typename VarAllocator::Literal computeOr(VarAllocator &allocator, ClauseEmitter
 		typename VarAllocator::Literal b) {
 	typename VarAllocator::Variable r = allocator.allocate();
 
-	emit(emitter, { a, b, r.zeroLiteral() });
-	emit(emitter, { r.oneLiteral(), a.inverse() });
-	emit(emitter, { r.oneLiteral(), b.inverse() });
+	const typename ClauseEmitter::Literal literals[] = {
+		a, b, r.zeroLiteral(),
+		r.oneLiteral(), a.inverse(),
+		r.oneLiteral(), b.inverse()
+	};
+	static const unsigned int sizes[] = { 3, 2, 2 };
+	emitBlock(emitter, literals, sizes);
 
 	return r.oneLiteral();
 }
@@ -52,12 +56,19 @@ typename VarAllocator::Literal computeOrN(VarAllocator &allocator, ClauseEmitter
 		Iterator begin, Iterator end) {
 	typename VarAllocator::Variable r = allocator.allocate();
 
-	std::vector<typename ClauseEmitter::Literal> c(begin, end);
-	c.push_back(r.zeroLiteral());
-	emitter.emit(c.begin(), c.end());
-
-	for(auto it = begin; it != end; it++)
-		emit(emitter, { r.oneLiteral(), it->inverse() });
+	// the long clause followed by one binary clause per input
+	size_t n = std::distance(begin, end);
+	std::vector<typename ClauseEmitter::Literal> literals;
+	literals.reserve(3 * n + 1);
+	literals.insert(literals.end(), begin, end);
+	literals.push_back(r.zeroLiteral());
+	for(auto it = begin; it != end; it++) {
+		literals.push_back(r.oneLiteral());
+		literals.push_back(it->inverse());
+	}
+	std::vector<unsigned int> sizes(n + 1, 2);
+	sizes[0] = n + 1;
+	emitBlock(emitter, literals.data(), sizes.data(), sizes.size());
 
 	return r.oneLiteral();
 }
@@ -68,9 +79,13 @@ typename VarAllocator::Literal computeAnd(VarAllocator &allocator, ClauseEmitter
 		typename VarAllocator::Literal b) {
 	typename VarAllocator::Variable r = allocator.allocate();
 
-	emit(emitter, { a.inverse(), b.inverse(), r.oneLiteral() });
-	emit(emitter, { r.zeroLiteral(), a });
-	emit(emitter, { r.zeroLiteral(), b });
+	const typename ClauseEmitter::Literal literals[] = {
+		a.inverse(), b.inverse(), r.oneLiteral(),
+		r.zeroLiteral(), a,
+		r.zeroLiteral(), b
+	};
+	static const unsigned int sizes[] = { 3, 2, 2 };
+	emitBlock(emitter, literals, sizes);
 
 	return r.oneLiteral();
 }
@@ -81,14 +96,127 @@ typename VarAllocator::Literal computeXor(VarAllocator &allocator, ClauseEmitter
 		typename VarAllocator::Literal b) {
 	typename VarAllocator::Variable r = allocator.allocate();
 
-	emit(emitter, { a.inverse(), b.inverse(), r.zeroLiteral() });
-	emit(emitter, { a.inverse(), b, r.oneLiteral() });
-	emit(emitter, { a, b.inverse(), r.oneLiteral() });
-	emit(emitter, { a, b, r.zeroLiteral() });
+	const typename ClauseEmitter::Literal literals[] = {
+		a.inverse(), b.inverse(), r.zeroLiteral(),
+		a.inverse(), b, r.oneLiteral(),
+		a, b.inverse(), r.oneLiteral(),
+		a, b, r.zeroLiteral()
+	};
+	static const unsigned int sizes[] = { 3, 3, 3, 3 };
+	emitBlock(emitter, literals, sizes);
 
 	return r.oneLiteral();
 }
 
+// produces the constraint lits[0] xor ... xor lits[n - 1] = rhs
+// directly: one clause per assignment with the wrong parity, i.e. 2^(n - 1) clauses
+template<typename VarAllocator, typename ClauseEmitter>
+void forceParityDirect(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits, bool rhs) {
+	size_t n = lits.size();
+	if(n == 0) {
+		if(rhs)
+			forceContradiction(allocator, emitter);
+		return;
+	}
+	if(n > 31)
+		throw std::invalid_argument("Too many literals for a direct parity encoding");
+
+	std::vector<typename ClauseEmitter::Literal> literals;
+	literals.reserve(n << (n - 1));
+	for(uint32_t mask = 0; mask < (uint32_t(1) << n); mask++) {
+		// bit i of mask is the value of lits[i] in the excluded assignment
+		if((popCount(mask) % 2 == 1) == rhs)
+			continue;
+		for(size_t i = 0; i < n; i++)
+			literals.push_back((mask >> i) & 1 ? lits[i].inverse() : lits[i]);
+	}
+	std::vector<unsigned int> sizes(literals.size() / n, n);
+	emitBlock(emitter, literals.data(), sizes.data(), sizes.size());
+}
+
+// replaces each chunk of up to cut - 1 literals by a fresh literal
+// that is equivalent to the parity of the chunk
+template<typename VarAllocator, typename ClauseEmitter>
+std::vector<typename ClauseEmitter::Literal> computeParityLevel(VarAllocator &allocator,
+		ClauseEmitter &emitter, const std::vector<typename ClauseEmitter::Literal> &lits,
+		int cut) {
+	assert(cut >= 3);
+	size_t chunk = cut - 1;
+	size_t num_chunks = (lits.size() + chunk - 1) / chunk;
+
+	std::vector<typename ClauseEmitter::Literal> outs;
+	for(size_t c = 0; c < num_chunks; c++) {
+		// distribute the literals evenly among the chunks
+		size_t begin = c * lits.size() / num_chunks;
+		size_t end = (c + 1) * lits.size() / num_chunks;
+		if(end - begin == 1) {
+			outs.push_back(lits[begin]);
+			continue;
+		}
+
+		std::vector<typename ClauseEmitter::Literal> ins(lits.begin() + begin,
+				lits.begin() + end);
+		typename ClauseEmitter::Literal r = allocator.allocate().oneLiteral();
+		ins.push_back(r);
+		forceParityDirect(allocator, emitter, ins, false);
+		outs.push_back(r);
+	}
+	return outs;
+}
+
+// produces a literal that is equivalent to lits[0] xor ... xor lits[n - 1].
+// the literals are combined in a balanced tree; each node of the tree is
+// a direct encoding over at most cut literals including its output.
+// cut must be between 3 and 31
+template<typename VarAllocator, typename ClauseEmitter>
+typename ClauseEmitter::Literal computeParityN(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits, int cut) {
+	if(cut < 3 || cut > 31)
+		throw std::invalid_argument("Cut length must be between 3 and 31");
+	if(lits.size() == 0) {
+		typename ClauseEmitter::Variable r = allocator.allocate();
+
+		// trivial case: the parity of no literals is zero
+		emit(emitter, { r.zeroLiteral() });
+
+		return r.oneLiteral();
+	}
+
+	std::vector<typename ClauseEmitter::Literal> level = lits;
+	while(level.size() > 1)
+		level = computeParityLevel(allocator, emitter, level, cut);
+	return level.front();
+}
+
+// produces the constraint lits[0] xor ... xor lits[n - 1] = rhs in CNF.
+// the literals are reduced in a balanced tree until at most cut literals
+// remain, which are then encoded directly. cut must be between 3 and 31
+template<typename VarAllocator, typename ClauseEmitter>
+void forceXorN(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits, bool rhs, int cut) {
+	if(cut < 3 || cut > 31)
+		throw std::invalid_argument("Cut length must be between 3 and 31");
+	std::vector<typename ClauseEmitter::Literal> level = lits;
+	while(level.size() > (size_t)cut)
+		level = computeParityLevel(allocator, emitter, level, cut);
+	forceParityDirect(allocator, emitter, level, rhs);
+}
+
+// produces the constraint lits[0] xor ... xor lits[n - 1] = rhs as a
+// native XOR clause for solvers that support Gaussian elimination.
+// requires an emitter that provides emitXor()
+template<typename VarAllocator, typename ClauseEmitter>
+void forceXorClause(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits, bool rhs) {
+	if(lits.size() == 0) {
+		if(rhs)
+			forceContradiction(allocator, emitter);
+		return;
+	}
+	emitter.emitXor(lits.begin(), lits.end(), rhs);
+}
+
 template<typename VarAllocator, typename ClauseEmitter>
 std::pair<typename VarAllocator::Literal, typename VarAllocator::Literal>
 computeHalfAdd(VarAllocator &allocator, ClauseEmitter &emitter,
@@ -134,10 +262,19 @@ std::vector<typename VarAllocator::Literal> computeAddN(VarAllocator &allocator,
 template<typename VarAllocator, typename ClauseEmitter>
 void forceAtMostOne(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &ins) {
+	if(ins.size() < 2)
+		return;
+
+	// one binary clause per unordered pair
+	std::vector<typename ClauseEmitter::Literal> literals;
+	literals.reserve(ins.size() * (ins.size() - 1));
 	for(auto i = ins.begin(); i != ins.end(); ++i)
-		for(auto j = ins.begin(); j != ins.end(); ++j)
-			if(i != j)
-				emit(emitter, { i->inverse(), j->inverse() });
+		for(auto j = i + 1; j != ins.end(); ++j) {
+			literals.push_back(i->inverse());
+			literals.push_back(j->inverse());
+		}
+	std::vector<unsigned int> sizes(literals.size() / 2, 2);
+	emitBlock(emitter, literals.data(), sizes.data(), sizes.size());
 }
 
 } // namespace encodeuzk
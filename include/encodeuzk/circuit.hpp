@@ -0,0 +1,192 @@
+
+namespace encodeuzk {
+
+template<typename BaseDefs>
+class Circuit;
+
+template<typename BaseDefs>
+class CircuitAllocator;
+
+template<typename BaseDefs>
+class CircuitEmitter;
+
+// kinds of nodes in a circuit. every node defines one variable;
+// OR gates are represented as AND gates with inverted inputs and output
+enum class CircuitGate {
+	// variable 0 is the only constant node; its one literal is true
+	Constant,
+	// an input of the circuit that is bound to a literal during lowering
+	Input,
+	// a variable that was allocated but is not defined by a gate
+	Free,
+	// a variable that is equivalent to its single fanin literal
+	Alias,
+	And,
+	// parity of two or more fanins
+	Xor
+};
+
+template<typename BaseDefs>
+struct CircuitDefs {
+	typedef StaticVariable<BaseDefs> Variable;
+	typedef StaticLiteral<BaseDefs> Literal;
+	typedef CircuitAllocator<BaseDefs> VarAllocator;
+	typedef CircuitEmitter<BaseDefs> ClauseEmitter;
+};
+
+template<typename BaseDefs>
+class CircuitAllocator {
+public:
+	typedef CircuitDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+
+	CircuitAllocator(Circuit<BaseDefs> &circuit);
+
+	Variable allocate();
+	VariableRange<Variable> allocateRange(size_t n);
+
+	Circuit<BaseDefs> &circuit() {
+		return p_circuit;
+	}
+
+private:
+	Circuit<BaseDefs> &p_circuit;
+};
+
+// clauses that are emitted into a circuit are recorded as constraints.
+// unit clauses over free variables turn these variables into constants
+template<typename BaseDefs>
+class CircuitEmitter {
+public:
+	typedef CircuitDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+
+	CircuitEmitter(Circuit<BaseDefs> &circuit);
+
+	template<typename Iterator>
+	void emit(Iterator begin, Iterator end);
+
+	Circuit<BaseDefs> &circuit() {
+		return p_circuit;
+	}
+
+private:
+	Circuit<BaseDefs> &p_circuit;
+};
+
+// gate-level DAG that records the structure produced by the encoders.
+// gates are folded on construction; gates with two fanins are also
+// structurally hashed, wider gates are not. lowerCircuit() removes dead
+// gates, propagates constants and emits a polarity-aware Tseitin encoding
+// of the remaining gates
+template<typename BaseDefs>
+class Circuit {
+public:
+	typedef CircuitDefs<BaseDefs> Defs;
+	typedef typename Defs::Variable Variable;
+	typedef typename Defs::Literal Literal;
+	typedef typename Defs::VarAllocator VarAllocator;
+	typedef typename Defs::ClauseEmitter ClauseEmitter;
+
+	friend class CircuitAllocator<BaseDefs>;
+	friend class CircuitEmitter<BaseDefs>;
+
+	Circuit();
+
+	Literal constant(bool value) const {
+		return value ? Variable::fromIndex(0).oneLiteral()
+				: Variable::fromIndex(0).zeroLiteral();
+	}
+	bool isConstant(Literal lit) const {
+		return lit.variable().getIndex() == 0;
+	}
+
+	Variable addInput();
+
+	// outputs are kept alive and are encoded in both polarities
+	void markOutput(Literal lit);
+
+	Literal makeAnd(Literal a, Literal b);
+	template<typename Iterator>
+	Literal makeAnd(Iterator begin, Iterator end);
+	Literal makeOr(Literal a, Literal b);
+	Literal makeXor(Literal a, Literal b);
+	// lowerCircuit() encodes an XOR gate with k fanins directly,
+	// i.e. with 2^k clauses if both polarities are required.
+	// throws std::invalid_argument if more than 31 fanins remain
+	template<typename Iterator>
+	Literal makeXor(Iterator begin, Iterator end);
+
+	// turns a free variable into an alias of the given literal
+	void define(Variable var, Literal lit);
+
+	// follows aliases; the result is never an alias
+	Literal resolve(Literal lit) const;
+
+	size_t numVariables() const {
+		return p_nodes.size();
+	}
+	CircuitGate gate(Variable var) const {
+		return p_nodes[var.getIndex()].gate;
+	}
+	const Literal *faninBegin(Variable var) const {
+		return p_fanins.data() + p_nodes[var.getIndex()].firstFanin;
+	}
+	const Literal *faninEnd(Variable var) const {
+		const Node &node = p_nodes[var.getIndex()];
+		return p_fanins.data() + node.firstFanin + node.numFanins;
+	}
+
+	size_t numConstraints() const {
+		return p_constraintEnds.size();
+	}
+	const Literal *constraintBegin(size_t i) const {
+		return p_constraintLits.data() + (i == 0 ? 0 : p_constraintEnds[i - 1]);
+	}
+	const Literal *constraintEnd(size_t i) const {
+		return p_constraintLits.data() + p_constraintEnds[i];
+	}
+
+	const std::vector<Literal> &outputs() const {
+		return p_outputs;
+	}
+
+private:
+	struct Node {
+		CircuitGate gate;
+		uint32_t numFanins;
+		size_t firstFanin;
+	};
+
+	struct StrashKey {
+		CircuitGate gate;
+		typename BaseDefs::LiteralIndex a;
+		typename BaseDefs::LiteralIndex b;
+
+		bool operator== (const StrashKey &other) const {
+			return gate == other.gate && a == other.a && b == other.b;
+		}
+	};
+	struct StrashHash {
+		size_t operator() (const StrashKey &key) const {
+			uint64_t h = (uint64_t)key.a * 0x9E3779B97F4A7C15ULL;
+			h ^= (uint64_t)key.b + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+			return h ^ (uint64_t)key.gate;
+		}
+	};
+
+	Variable newNode(CircuitGate gate);
+	Literal newGate(CircuitGate gate, Literal a, Literal b);
+
+	std::vector<Node> p_nodes;
+	std::vector<Literal> p_fanins;
+	std::vector<Literal> p_constraintLits;
+	std::vector<size_t> p_constraintEnds;
+	std::vector<Literal> p_outputs;
+	std::unordered_map<StrashKey, Variable, StrashHash> p_strash;
+};
+
+}; // namespace encodeuzk
+
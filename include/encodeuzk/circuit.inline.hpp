@@ -0,0 +1,639 @@
+
+namespace encodeuzk {
+
+template<typename BaseDefs>
+CircuitAllocator<BaseDefs>::CircuitAllocator(Circuit<BaseDefs> &circuit)
+		: p_circuit(circuit) { }
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Variable CircuitAllocator<BaseDefs>::allocate() {
+	return p_circuit.newNode(CircuitGate::Free);
+}
+
+template<typename BaseDefs>
+VariableRange<typename CircuitDefs<BaseDefs>::Variable>
+CircuitAllocator<BaseDefs>::allocateRange(size_t n) {
+	Variable first = Variable::fromIndex(p_circuit.numVariables());
+	for(size_t i = 0; i < n; i++)
+		p_circuit.newNode(CircuitGate::Free);
+	return VariableRange<Variable>(first, n);
+}
+
+template<typename BaseDefs>
+CircuitEmitter<BaseDefs>::CircuitEmitter(Circuit<BaseDefs> &circuit)
+		: p_circuit(circuit) { }
+
+template<typename BaseDefs>
+template<typename Iterator>
+void CircuitEmitter<BaseDefs>::emit(Iterator begin, Iterator end) {
+	if(begin != end && std::next(begin) == end) {
+		Literal unit = p_circuit.resolve(*begin);
+		if(p_circuit.gate(unit.variable()) == CircuitGate::Free) {
+			p_circuit.define(unit.variable(), p_circuit.constant(unit.isOneLiteral()));
+			return;
+		}
+	}
+
+	for(auto it = begin; it != end; ++it)
+		p_circuit.p_constraintLits.push_back(*it);
+	p_circuit.p_constraintEnds.push_back(p_circuit.p_constraintLits.size());
+}
+
+template<typename BaseDefs>
+Circuit<BaseDefs>::Circuit() {
+	newNode(CircuitGate::Constant);
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Variable Circuit<BaseDefs>::newNode(CircuitGate gate) {
+	Node node;
+	node.gate = gate;
+	node.numFanins = 0;
+	node.firstFanin = p_fanins.size();
+	p_nodes.push_back(node);
+	return Variable::fromIndex(p_nodes.size() - 1);
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Variable Circuit<BaseDefs>::addInput() {
+	return newNode(CircuitGate::Input);
+}
+
+template<typename BaseDefs>
+void Circuit<BaseDefs>::markOutput(Literal lit) {
+	p_outputs.push_back(lit);
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::resolve(Literal lit) const {
+	while(gate(lit.variable()) == CircuitGate::Alias) {
+		Literal target = *faninBegin(lit.variable());
+		lit = lit.isOneLiteral() ? target : target.inverse();
+	}
+	return lit;
+}
+
+template<typename BaseDefs>
+void Circuit<BaseDefs>::define(Variable var, Literal lit) {
+	assert(gate(var) == CircuitGate::Free);
+	lit = resolve(lit);
+	assert(lit.variable() != var);
+
+	Node &node = p_nodes[var.getIndex()];
+	node.gate = CircuitGate::Alias;
+	node.numFanins = 1;
+	node.firstFanin = p_fanins.size();
+	p_fanins.push_back(lit);
+}
+
+// a and b are resolved, non-constant and sorted
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::newGate(CircuitGate gate,
+		Literal a, Literal b) {
+	StrashKey key;
+	key.gate = gate;
+	key.a = a.getIndex();
+	key.b = b.getIndex();
+	auto it = p_strash.find(key);
+	if(it != p_strash.end())
+		return it->second.oneLiteral();
+
+	Variable r = newNode(gate);
+	Node &node = p_nodes[r.getIndex()];
+	node.numFanins = 2;
+	p_fanins.push_back(a);
+	p_fanins.push_back(b);
+	p_strash.insert(std::make_pair(key, r));
+	return r.oneLiteral();
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::makeAnd(Literal a, Literal b) {
+	Literal ins[] = { a, b };
+	return makeAnd(ins, ins + 2);
+}
+
+template<typename BaseDefs>
+template<typename Iterator>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::makeAnd(Iterator begin, Iterator end) {
+	std::vector<Literal> ins;
+	for(auto it = begin; it != end; ++it) {
+		Literal lit = resolve(*it);
+		if(lit == constant(false))
+			return constant(false);
+		if(lit == constant(true))
+			continue;
+		ins.push_back(lit);
+	}
+
+	std::sort(ins.begin(), ins.end(), [] (Literal x, Literal y) {
+		return x.getIndex() < y.getIndex();
+	});
+	ins.erase(std::unique(ins.begin(), ins.end()), ins.end());
+	// after sorting a literal and its inverse are adjacent
+	for(size_t i = 1; i < ins.size(); i++)
+		if(ins[i - 1].variable() == ins[i].variable())
+			return constant(false);
+
+	if(ins.size() == 0)
+		return constant(true);
+	if(ins.size() == 1)
+		return ins.front();
+	if(ins.size() == 2)
+		return newGate(CircuitGate::And, ins[0], ins[1]);
+
+	Variable r = newNode(CircuitGate::And);
+	Node &node = p_nodes[r.getIndex()];
+	node.numFanins = ins.size();
+	p_fanins.insert(p_fanins.end(), ins.begin(), ins.end());
+	return r.oneLiteral();
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::makeOr(Literal a, Literal b) {
+	return makeAnd(a.inverse(), b.inverse()).inverse();
+}
+
+template<typename BaseDefs>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::makeXor(Literal a, Literal b) {
+	a = resolve(a);
+	b = resolve(b);
+
+	// move the polarity of both inputs to the output
+	bool invert = false;
+	if(!a.isOneLiteral()) {
+		a = a.inverse();
+		invert = !invert;
+	}
+	if(!b.isOneLiteral()) {
+		b = b.inverse();
+		invert = !invert;
+	}
+	if(b.getIndex() < a.getIndex())
+		std::swap(a, b);
+
+	Literal r;
+	if(isConstant(a)) {
+		r = b.inverse();
+	}else if(a == b) {
+		r = constant(false);
+	}else{
+		r = newGate(CircuitGate::Xor, a, b);
+	}
+	return invert ? r.inverse() : r;
+}
+
+template<typename BaseDefs>
+template<typename Iterator>
+typename CircuitDefs<BaseDefs>::Literal Circuit<BaseDefs>::makeXor(Iterator begin, Iterator end) {
+	// move the polarity of all inputs to the output
+	bool invert = false;
+	std::vector<Literal> ins;
+	for(auto it = begin; it != end; ++it) {
+		Literal lit = resolve(*it);
+		if(!lit.isOneLiteral()) {
+			lit = lit.inverse();
+			invert = !invert;
+		}
+		if(isConstant(lit)) {
+			invert = !invert;
+			continue;
+		}
+		ins.push_back(lit);
+	}
+
+	std::sort(ins.begin(), ins.end(), [] (Literal x, Literal y) {
+		return x.getIndex() < y.getIndex();
+	});
+	// equal inputs cancel each other
+	size_t n = 0;
+	for(size_t i = 0; i < ins.size(); i++) {
+		if(n > 0 && ins[n - 1] == ins[i]) {
+			n--;
+		}else{
+			ins[n++] = ins[i];
+		}
+	}
+	ins.resize(n);
+
+	if(ins.size() > 31)
+		throw std::invalid_argument("Too many fanins for an XOR gate");
+
+	Literal r;
+	if(ins.size() == 0) {
+		r = constant(false);
+	}else if(ins.size() == 1) {
+		r = ins.front();
+	}else if(ins.size() == 2) {
+		r = newGate(CircuitGate::Xor, ins[0], ins[1]);
+	}else{
+		Variable var = newNode(CircuitGate::Xor);
+		Node &node = p_nodes[var.getIndex()];
+		node.numFanins = ins.size();
+		p_fanins.insert(p_fanins.end(), ins.begin(), ins.end());
+		r = var.oneLiteral();
+	}
+	return invert ? r.inverse() : r;
+}
+
+// computes a post-order of all nodes that are reachable from the given roots,
+// i.e. every node appears after all of its fanins
+template<typename BaseDefs>
+std::vector<typename CircuitDefs<BaseDefs>::Variable> circuitPostOrder(const Circuit<BaseDefs> &circuit,
+		const std::vector<typename CircuitDefs<BaseDefs>::Variable> &roots) {
+	typedef typename CircuitDefs<BaseDefs>::Variable Variable;
+
+	std::vector<Variable> order;
+	// 0 = unvisited, 1 = expanded, 2 = finished
+	std::vector<char> state(circuit.numVariables(), 0);
+	std::vector<Variable> stack(roots.rbegin(), roots.rend());
+	while(!stack.empty()) {
+		Variable var = stack.back();
+		char &s = state[var.getIndex()];
+		if(s == 2) {
+			stack.pop_back();
+		}else if(s == 1) {
+			stack.pop_back();
+			s = 2;
+			order.push_back(var);
+		}else{
+			s = 1;
+			for(auto it = circuit.faninBegin(var); it != circuit.faninEnd(var); ++it)
+				if(state[it->variable().getIndex()] == 0)
+					stack.push_back(it->variable());
+		}
+	}
+	return order;
+}
+
+// lowers the circuit to CNF. on entry mapping may contain the literals that
+// are bound to the inputs of the circuit; unbound inputs receive fresh variables.
+// on exit mapping contains the literal that represents each live variable
+// of the circuit. only the literals of outputs, inputs and constants are fully
+// defined: internal gates only receive the clauses for the polarities that are
+// required by the constraints and outputs (Plaisted-Greenbaum), so their
+// literals must not be used in other polarities; mark such gates as outputs.
+// variables that are fixed to constants, e.g. by unit clauses, are mapped to
+// a literal that is fixed by a unit clause of its own; dead variables are
+// mapped to illegal literals
+template<typename BaseDefs, typename VarAllocator, typename ClauseEmitter>
+void lowerCircuit(const Circuit<BaseDefs> &circuit,
+		VarAllocator &allocator, ClauseEmitter &emitter,
+		std::vector<typename ClauseEmitter::Literal> &mapping) {
+	typedef typename CircuitDefs<BaseDefs>::Variable Variable;
+	typedef typename CircuitDefs<BaseDefs>::Literal Literal;
+	typedef typename ClauseEmitter::Literal TargetLiteral;
+
+	const Literal true_lit = circuit.constant(true);
+	const Literal false_lit = circuit.constant(false);
+	mapping.resize(circuit.numVariables(), TargetLiteral::illegalLit());
+
+	std::vector<Variable> roots;
+	for(size_t i = 0; i < circuit.numConstraints(); i++)
+		for(auto it = circuit.constraintBegin(i); it != circuit.constraintEnd(i); ++it)
+			roots.push_back(it->variable());
+	for(auto it = circuit.outputs().begin(); it != circuit.outputs().end(); ++it)
+		roots.push_back(it->variable());
+	std::vector<Variable> order = circuitPostOrder(circuit, roots);
+
+	// constant propagation: simplified[v] is the literal that is equivalent to v.
+	// a variable is canonical if it is simplified to itself
+	std::vector<Literal> simplified(circuit.numVariables());
+	auto simplify = [&] (Literal lit) {
+		Literal s = simplified[lit.variable().getIndex()];
+		return lit.isOneLiteral() ? s : s.inverse();
+	};
+	// collects the non-constant fanins of a canonical AND gate
+	std::vector<Literal> fanins;
+	auto collectAnd = [&] (Variable var) {
+		fanins.clear();
+		for(auto it = circuit.faninBegin(var); it != circuit.faninEnd(var); ++it) {
+			Literal lit = simplify(*it);
+			if(lit != true_lit)
+				fanins.push_back(lit);
+		}
+	};
+	// collects the non-constant fanins of a canonical XOR gate as positive
+	// literals, cancelling equal fanins. returns true if the gate is the
+	// inverse of the parity of the collected fanins
+	auto collectXor = [&] (Variable var) {
+		fanins.clear();
+		bool invert = false;
+		for(auto it = circuit.faninBegin(var); it != circuit.faninEnd(var); ++it) {
+			Literal lit = simplify(*it);
+			if(!lit.isOneLiteral()) {
+				lit = lit.inverse();
+				invert = !invert;
+			}
+			if(lit == true_lit) {
+				invert = !invert;
+				continue;
+			}
+			fanins.push_back(lit);
+		}
+		std::sort(fanins.begin(), fanins.end(), [] (Literal x, Literal y) {
+			return x.getIndex() < y.getIndex();
+		});
+		size_t n = 0;
+		for(size_t i = 0; i < fanins.size(); i++) {
+			if(n > 0 && fanins[n - 1] == fanins[i]) {
+				n--;
+			}else{
+				fanins[n++] = fanins[i];
+			}
+		}
+		fanins.resize(n);
+		return invert;
+	};
+
+	for(auto it = order.begin(); it != order.end(); ++it) {
+		Variable var = *it;
+		Literal &s = simplified[var.getIndex()];
+		switch(circuit.gate(var)) {
+		case CircuitGate::Constant:
+			s = true_lit;
+			break;
+		case CircuitGate::Input:
+		case CircuitGate::Free:
+			s = var.oneLiteral();
+			break;
+		case CircuitGate::Alias:
+			s = simplify(*circuit.faninBegin(var));
+			break;
+		case CircuitGate::And: {
+			collectAnd(var);
+			std::sort(fanins.begin(), fanins.end(), [] (Literal x, Literal y) {
+				return x.getIndex() < y.getIndex();
+			});
+			fanins.erase(std::unique(fanins.begin(), fanins.end()), fanins.end());
+			s = var.oneLiteral();
+			if(fanins.size() == 0) {
+				s = true_lit;
+			}else if(fanins.size() == 1) {
+				s = fanins.front();
+			}
+			for(size_t i = 0; i < fanins.size(); i++)
+				if(fanins[i] == false_lit
+						|| (i > 0 && fanins[i - 1].variable() == fanins[i].variable()))
+					s = false_lit;
+			break;
+		}
+		case CircuitGate::Xor: {
+			bool invert = collectXor(var);
+			if(fanins.size() == 0) {
+				s = invert ? true_lit : false_lit;
+			}else if(fanins.size() == 1) {
+				s = invert ? fanins.front().inverse() : fanins.front();
+			}else{
+				s = var.oneLiteral();
+			}
+			break;
+		}
+		}
+	}
+
+	// polarity analysis: bit 1 requires the clauses for var -> gate,
+	// bit 2 requires the clauses for gate -> var (Plaisted-Greenbaum)
+	std::vector<char> required(circuit.numVariables(), 0);
+	auto require = [&] (Literal lit, char bits) {
+		Literal s = simplify(lit);
+		if(circuit.isConstant(s))
+			return;
+		if(!s.isOneLiteral())
+			bits = ((bits & 1) << 1) | ((bits & 2) >> 1);
+		required[s.variable().getIndex()] |= bits;
+	};
+
+	for(size_t i = 0; i < circuit.numConstraints(); i++)
+		for(auto it = circuit.constraintBegin(i); it != circuit.constraintEnd(i); ++it)
+			require(*it, 1);
+	for(auto it = circuit.outputs().begin(); it != circuit.outputs().end(); ++it)
+		require(*it, 3);
+
+	for(auto it = order.rbegin(); it != order.rend(); ++it) {
+		Variable var = *it;
+		char bits = required[var.getIndex()];
+		if(!bits || simplified[var.getIndex()] != var.oneLiteral())
+			continue;
+		if(circuit.gate(var) == CircuitGate::And) {
+			collectAnd(var);
+			for(auto jt = fanins.begin(); jt != fanins.end(); ++jt)
+				require(*jt, bits);
+		}else if(circuit.gate(var) == CircuitGate::Xor) {
+			for(auto jt = circuit.faninBegin(var); jt != circuit.faninEnd(var); ++jt)
+				require(*jt, 3);
+		}
+	}
+
+	// emit the clauses of all required canonical variables
+	auto translate = [&] (Literal lit) {
+		TargetLiteral t = mapping[lit.variable().getIndex()];
+		return lit.isOneLiteral() ? t : t.inverse();
+	};
+
+	std::vector<TargetLiteral> clause;
+	for(auto it = order.begin(); it != order.end(); ++it) {
+		Variable var = *it;
+		char bits = required[var.getIndex()];
+		if(!bits || simplified[var.getIndex()] != var.oneLiteral())
+			continue;
+
+		TargetLiteral &t = mapping[var.getIndex()];
+		if(circuit.gate(var) != CircuitGate::Input || t == TargetLiteral::illegalLit())
+			t = allocator.allocate().oneLiteral();
+
+		if(circuit.gate(var) == CircuitGate::And) {
+			collectAnd(var);
+			if(bits & 1)
+				for(auto jt = fanins.begin(); jt != fanins.end(); ++jt)
+					emit(emitter, { t.inverse(), translate(*jt) });
+			if(bits & 2) {
+				clause.clear();
+				for(auto jt = fanins.begin(); jt != fanins.end(); ++jt)
+					clause.push_back(translate(*jt).inverse());
+				clause.push_back(t);
+				emit(emitter, clause);
+			}
+		}else if(circuit.gate(var) == CircuitGate::Xor) {
+			// one clause per assignment of the fanins; bit i of mask is
+			// the value of the i-th fanin in the excluded assignment
+			bool invert = collectXor(var);
+			for(uint64_t mask = 0; mask < (uint64_t(1) << fanins.size()); mask++) {
+				bool value = (popCount(mask) % 2 == 1) != invert;
+				if(!(bits & (value ? 2 : 1)))
+					continue;
+				clause.clear();
+				for(size_t i = 0; i < fanins.size(); i++)
+					clause.push_back((mask >> i) & 1 ? translate(fanins[i]).inverse()
+							: translate(fanins[i]));
+				clause.push_back(value ? t : t.inverse());
+				emit(emitter, clause);
+			}
+		}
+	}
+
+	for(size_t i = 0; i < circuit.numConstraints(); i++) {
+		clause.clear();
+		bool satisfied = false;
+		for(auto it = circuit.constraintBegin(i); it != circuit.constraintEnd(i); ++it) {
+			Literal s = simplify(*it);
+			if(s == true_lit)
+				satisfied = true;
+			if(!circuit.isConstant(s))
+				clause.push_back(translate(s));
+		}
+		if(!satisfied)
+			emit(emitter, clause);
+	}
+
+	// variables that are not reachable from the roots are dead unless
+	// they are aliases, e.g. variables that were fixed by unit clauses
+	std::vector<char> reachable(circuit.numVariables(), 0);
+	for(auto it = order.begin(); it != order.end(); ++it)
+		reachable[it->getIndex()] = 1;
+	auto canonical = [&] (Variable var) {
+		if(reachable[var.getIndex()])
+			return simplified[var.getIndex()];
+		Literal r = circuit.resolve(var.oneLiteral());
+		return reachable[r.variable().getIndex()] ? simplify(r) : r;
+	};
+
+	// variables that were simplified to constants still need a literal
+	for(size_t i = 1; i < circuit.numVariables(); i++) {
+		if(circuit.isConstant(canonical(Variable::fromIndex(i)))
+				&& mapping[0] == TargetLiteral::illegalLit()) {
+			mapping[0] = allocator.allocate().oneLiteral();
+			emit(emitter, { mapping[0] });
+		}
+	}
+
+	for(size_t i = 1; i < circuit.numVariables(); i++) {
+		Literal s = canonical(Variable::fromIndex(i));
+		if(mapping[s.variable().getIndex()] != TargetLiteral::illegalLit())
+			mapping[i] = translate(s);
+	}
+}
+
+// gate helpers that record gates in the circuit instead of emitting clauses.
+// they are picked up by overload resolution whenever the encoders
+// are instantiated with a CircuitAllocator and a CircuitEmitter
+
+template<typename BaseDefs>
+StaticLiteral<BaseDefs> computeOr(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		StaticLiteral<BaseDefs> a,
+		StaticLiteral<BaseDefs> b) {
+	return allocator.circuit().makeOr(a, b);
+}
+
+template<typename BaseDefs, typename Iterator>
+StaticLiteral<BaseDefs> computeOrN(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		Iterator begin, Iterator end) {
+	std::vector<StaticLiteral<BaseDefs>> ins;
+	for(auto it = begin; it != end; ++it)
+		ins.push_back(it->inverse());
+	return allocator.circuit().makeAnd(ins.begin(), ins.end()).inverse();
+}
+
+template<typename BaseDefs>
+StaticLiteral<BaseDefs> computeAnd(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		StaticLiteral<BaseDefs> a,
+		StaticLiteral<BaseDefs> b) {
+	return allocator.circuit().makeAnd(a, b);
+}
+
+template<typename BaseDefs>
+StaticLiteral<BaseDefs> computeXor(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		StaticLiteral<BaseDefs> a,
+		StaticLiteral<BaseDefs> b) {
+	return allocator.circuit().makeXor(a, b);
+}
+
+template<typename BaseDefs>
+StaticLiteral<BaseDefs> computeParityN(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		const std::vector<StaticLiteral<BaseDefs>> &lits, int cut) {
+	if(cut < 3 || cut > 31)
+		throw std::invalid_argument("Cut length must be between 3 and 31");
+	Circuit<BaseDefs> &circuit = allocator.circuit();
+	if(lits.size() == 0)
+		return circuit.constant(false);
+
+	// a balanced tree of XOR gates with up to cut - 1 fanins each,
+	// like the tree of direct encodings built by the generic computeParityN
+	std::vector<StaticLiteral<BaseDefs>> level = lits;
+	while(level.size() > 1) {
+		size_t chunk = cut - 1;
+		size_t num_chunks = (level.size() + chunk - 1) / chunk;
+
+		std::vector<StaticLiteral<BaseDefs>> next;
+		for(size_t c = 0; c < num_chunks; c++) {
+			size_t begin = c * level.size() / num_chunks;
+			size_t end = (c + 1) * level.size() / num_chunks;
+			next.push_back(circuit.makeXor(level.begin() + begin, level.begin() + end));
+		}
+		level.swap(next);
+	}
+	return level.front();
+}
+
+// output k (counting from zero) is the disjunction of the conjunctions
+// a[i - 1] and b[j - 1] over all i + j = k + 1, where a[-1] and b[-1] are true
+template<typename BaseDefs>
+std::vector<StaticLiteral<BaseDefs>> computeDirectMerge(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		const std::vector<StaticLiteral<BaseDefs>> &a,
+		const std::vector<StaticLiteral<BaseDefs>> &b,
+		StaticLiteral<BaseDefs> null_lit) {
+	Circuit<BaseDefs> &circuit = allocator.circuit();
+	size_t p = a.size();
+	size_t q = b.size();
+
+	// null_lit is folded like any other constant
+	std::vector<StaticLiteral<BaseDefs>> outs;
+	std::vector<StaticLiteral<BaseDefs>> terms;
+	for(size_t k = 1; k <= p + q; k++) {
+		terms.clear();
+		for(size_t i = k > q ? k - q : 0; i <= std::min(k, p); i++) {
+			StaticLiteral<BaseDefs> x = i > 0 ? a[i - 1] : circuit.constant(true);
+			StaticLiteral<BaseDefs> y = k - i > 0 ? b[k - i - 1] : circuit.constant(true);
+			terms.push_back(circuit.makeAnd(x, y).inverse());
+		}
+		outs.push_back(circuit.makeAnd(terms.begin(), terms.end()).inverse());
+	}
+	return outs;
+}
+
+template<typename BaseDefs>
+void forceComparator(CircuitAllocator<BaseDefs> &allocator,
+		CircuitEmitter<BaseDefs> &emitter,
+		StaticLiteral<BaseDefs> x1,
+		StaticLiteral<BaseDefs> x2,
+		StaticLiteral<BaseDefs> y1,
+		StaticLiteral<BaseDefs> y2) {
+	Circuit<BaseDefs> &circuit = allocator.circuit();
+	if(y1.variable() == y2.variable()
+			|| circuit.gate(y1.variable()) != CircuitGate::Free
+			|| circuit.gate(y2.variable()) != CircuitGate::Free) {
+		// the outputs are already defined; fall back to plain clauses
+		emit(emitter, { x1.inverse(), y1 });
+		emit(emitter, { x2.inverse(), y1 });
+		emit(emitter, { x1.inverse(), x2.inverse(), y2 });
+		emit(emitter, { y2.inverse(), x1 });
+		emit(emitter, { y2.inverse(), x2 });
+		emit(emitter, { y1.inverse(), x1, x2 });
+		return;
+	}
+
+	// y1 = max(x1, x2), y2 = min(x1, x2)
+	StaticLiteral<BaseDefs> max = circuit.makeOr(x1, x2);
+	StaticLiteral<BaseDefs> min = circuit.makeAnd(x1, x2);
+	circuit.define(y1.variable(), y1.isOneLiteral() ? max : max.inverse());
+	circuit.define(y2.variable(), y2.isOneLiteral() ? min : min.inverse());
+}
+
+} // namespace encodeuzk
+
@@ -1,12 +1,46 @@
 
 namespace encodeuzk {
 
+// the number of bits that are set in x
+inline int popCount(uint64_t x) {
+	x = x - ((x >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (x * 0x0101010101010101ULL) >> 56;
+}
+
+template<typename VarAllocator>
+auto allocateRangeDispatch(VarAllocator &allocator, size_t n, int)
+		-> decltype(allocator.allocateRange(n)) {
+	return allocator.allocateRange(n);
+}
+template<typename VarAllocator>
+std::vector<typename VarAllocator::Variable> allocateRangeDispatch(VarAllocator &allocator,
+		size_t n, long) {
+	std::vector<typename VarAllocator::Variable> result;
+	result.reserve(n);
+	for(size_t i = 0; i < n; i++)
+		result.push_back(allocator.allocate());
+	return result;
+}
+
+// allocates n variables that can be accessed through operator[].
+// allocators that provide allocateRange() return consecutive variables,
+// other allocators receive n calls to allocate()
+template<typename VarAllocator>
+auto allocateRange(VarAllocator &allocator, size_t n)
+		-> decltype(allocateRangeDispatch(allocator, n, 0)) {
+	return allocateRangeDispatch(allocator, n, 0);
+}
+
 template<typename VarAllocator>
 std::vector<typename VarAllocator::Variable> allocateN(VarAllocator &allocator,
 		size_t n) {
+	auto range = allocateRange(allocator, n);
 	std::vector<typename VarAllocator::Variable> result;
+	result.reserve(n);
 	for(size_t i = 0; i < n; i++)
-		result.push_back(allocator.allocate());
+		result.push_back(range[i]);
 	return result;
 }
 
@@ -35,5 +69,36 @@ void emit(ClauseEmitter &emitter, const std::initializer_list<typename ClauseEmi
 	emitter.emit(container.begin(), container.end());
 }
 
+template<typename ClauseEmitter, typename Literal>
+auto emitBlockDispatch(ClauseEmitter &emitter, const Literal *literals,
+		const unsigned int *sizes, size_t num_clauses, int)
+		-> decltype(emitter.emitBlock(literals, sizes, num_clauses)) {
+	return emitter.emitBlock(literals, sizes, num_clauses);
+}
+template<typename ClauseEmitter, typename Literal>
+void emitBlockDispatch(ClauseEmitter &emitter, const Literal *literals,
+		const unsigned int *sizes, size_t num_clauses, long) {
+	for(size_t i = 0; i < num_clauses; i++) {
+		emitter.emit(literals, literals + sizes[i]);
+		literals += sizes[i];
+	}
+}
+
+// emits num_clauses clauses whose literals are stored back to back;
+// sizes[i] is the length of the i-th clause. emitters that provide
+// emitBlock() receive the whole block at once, other emitters
+// receive one clause at a time
+template<typename ClauseEmitter, typename Literal>
+void emitBlock(ClauseEmitter &emitter, const Literal *literals,
+		const unsigned int *sizes, size_t num_clauses) {
+	emitBlockDispatch(emitter, literals, sizes, num_clauses, 0);
+}
+template<typename ClauseEmitter, typename Literal, size_t L, size_t N>
+void emitBlock(ClauseEmitter &emitter, const Literal (&literals)[L],
+		const unsigned int (&sizes)[N]) {
+	assert(std::accumulate(sizes, sizes + N, size_t(0)) == L);
+	emitBlockDispatch(emitter, literals, sizes, N, 0);
+}
+
 } // namespace encodeuzk
 
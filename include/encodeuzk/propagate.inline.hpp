@@ -0,0 +1,248 @@
+
+namespace encodeuzk {
+
+// unit propagation over the clauses of a StaticFormula using two watched
+// literals per clause. literals are addressed by their literal index
+template<typename BaseDefs>
+class StaticPropagator {
+public:
+	typedef StaticLiteral<BaseDefs> Literal;
+	typedef typename BaseDefs::LiteralIndex Index;
+
+	StaticPropagator(const StaticFormula<BaseDefs> &formula)
+			: p_values(2 * formula.numVariables(), 0),
+			p_watches(2 * formula.numVariables()),
+			p_head(0), p_inconsistent(false), p_propagations(0) {
+		std::vector<Index> units;
+		const std::vector<int> &clauses = formula.clauses();
+		p_begins.push_back(0);
+		for(size_t in = 0; in < clauses.size(); ) {
+			size_t begin = p_literals.size();
+			for(; clauses[in] != 0; in++)
+				p_literals.push_back(Literal::fromNumber(clauses[in]).getIndex());
+			in++;
+
+			size_t length = p_literals.size() - begin;
+			if(length == 0) {
+				p_inconsistent = true;
+			}else if(length == 1) {
+				units.push_back(p_literals[begin]);
+			}else{
+				p_watches[p_literals[begin]].push_back(p_begins.size() - 1);
+				p_watches[p_literals[begin + 1]].push_back(p_begins.size() - 1);
+			}
+			p_begins.push_back(p_literals.size());
+		}
+
+		for(auto it = units.begin(); it != units.end(); ++it) {
+			if(p_values[*it] == -1)
+				p_inconsistent = true;
+			if(p_values[*it] == 0)
+				assign(*it);
+		}
+		if(!propagate())
+			p_inconsistent = true;
+		p_propagations = 0;
+	}
+
+	// true if unit propagation without assumptions already fails
+	bool inconsistent() const {
+		return p_inconsistent;
+	}
+
+	// returns 1 if the literal is true, -1 if it is false and 0 otherwise
+	int value(Literal lit) const {
+		return p_values[lit.getIndex()];
+	}
+
+	size_t level() const {
+		return p_levels.size();
+	}
+
+	// opens a new decision level, assigns the literal and propagates.
+	// returns false on conflict; the caller has to backtrack afterwards
+	bool assume(Literal lit) {
+		p_levels.push_back(p_trail.size());
+		if(p_values[lit.getIndex()] != 0)
+			return p_values[lit.getIndex()] == 1;
+		assign(lit.getIndex());
+		return propagate();
+	}
+
+	void backtrack(size_t level) {
+		if(level >= p_levels.size())
+			return;
+		for(size_t i = p_levels[level]; i < p_trail.size(); i++) {
+			p_values[p_trail[i]] = 0;
+			p_values[p_trail[i] ^ 1] = 0;
+		}
+		p_trail.resize(p_levels[level]);
+		p_levels.resize(level);
+		p_head = p_trail.size();
+	}
+
+	// number of literals that were assigned by propagation (not by assume())
+	uint64_t numPropagations() const {
+		return p_propagations;
+	}
+
+private:
+	void assign(Index lit) {
+		p_values[lit] = 1;
+		p_values[lit ^ 1] = -1;
+		p_trail.push_back(lit);
+	}
+
+	bool propagate() {
+		while(p_head < p_trail.size()) {
+			Index falsified = p_trail[p_head++] ^ 1;
+			std::vector<size_t> &watches = p_watches[falsified];
+
+			size_t j = 0;
+			for(size_t i = 0; i < watches.size(); i++) {
+				size_t clause = watches[i];
+				Index *lits = p_literals.data() + p_begins[clause];
+				size_t length = p_begins[clause + 1] - p_begins[clause];
+				if(lits[0] == falsified)
+					std::swap(lits[0], lits[1]);
+
+				if(p_values[lits[0]] == 1) {
+					watches[j++] = clause;
+					continue;
+				}
+
+				bool moved = false;
+				for(size_t k = 2; k < length; k++) {
+					if(p_values[lits[k]] != -1) {
+						std::swap(lits[1], lits[k]);
+						p_watches[lits[1]].push_back(clause);
+						moved = true;
+						break;
+					}
+				}
+				if(moved)
+					continue;
+
+				watches[j++] = clause;
+				if(p_values[lits[0]] == -1) {
+					for(i++; i < watches.size(); i++)
+						watches[j++] = watches[i];
+					watches.resize(j);
+					return false;
+				}
+				assign(lits[0]);
+				p_propagations++;
+			}
+			watches.resize(j);
+		}
+		return true;
+	}
+
+	std::vector<Index> p_literals;
+	std::vector<size_t> p_begins;
+	std::vector<signed char> p_values;
+	std::vector<std::vector<size_t>> p_watches;
+	std::vector<Index> p_trail;
+	std::vector<size_t> p_levels;
+	size_t p_head;
+	bool p_inconsistent;
+	uint64_t p_propagations;
+};
+
+struct PropagationStats {
+	PropagationStats() : rounds(0), decisions(0), propagations(0), conflicts(0),
+			missedImplications(0), missedConflicts(0), wrongConflicts(0), seconds(0) { }
+
+	uint64_t rounds;
+	uint64_t decisions;
+	uint64_t propagations;
+	uint64_t conflicts;
+	// input literals that are implied by the constraint but not by propagation,
+	// summed over all decisions
+	uint64_t missedImplications;
+	// violated constraints that were not detected by propagation
+	uint64_t missedConflicts;
+	// conflicts on assignments that do not violate the constraint;
+	// these indicate an incorrect encoding
+	uint64_t wrongConflicts;
+	double seconds;
+
+	double propagationsPerSecond() const {
+		return seconds > 0 ? propagations / seconds : 0;
+	}
+};
+
+// benchmarks unit propagation on a formula that encodes the constraint
+// sum weights[i] * lits[i] >= rhs. each round assigns a random number of
+// inputs in random order. after each decision the values of the inputs
+// are compared with the implications of the constraint, i.e. propagation
+// is checked for generalized arc consistency. only propagation is timed
+template<typename BaseDefs, typename Weight>
+PropagationStats benchmarkPropagation(const StaticFormula<BaseDefs> &formula,
+		const std::vector<StaticLiteral<BaseDefs>> &lits,
+		const std::vector<Weight> &weights, Weight rhs,
+		uint64_t rounds, uint64_t seed) {
+	assert(lits.size() == weights.size());
+
+	PropagationStats stats;
+	StaticPropagator<BaseDefs> propagator(formula);
+	if(propagator.inconsistent())
+		return stats;
+
+	std::mt19937_64 generator(seed);
+	std::vector<size_t> order(lits.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::vector<char> decided(lits.size(), 0);
+
+	for(uint64_t round = 0; round < rounds; round++) {
+		std::shuffle(order.begin(), order.end(), generator);
+		size_t num_decisions = lits.empty() ? 0 : 1 + generator() % lits.size();
+		std::fill(decided.begin(), decided.end(), 0);
+		uint64_t props_before = propagator.numPropagations();
+
+		for(size_t d = 0; d < num_decisions; d++) {
+			size_t i = order[d];
+			if(propagator.value(lits[i]) != 0)
+				continue;
+			StaticLiteral<BaseDefs> decision = generator() & 1 ? lits[i] : lits[i].inverse();
+			decided[i] = decision == lits[i] ? 1 : -1;
+			stats.decisions++;
+
+			auto start = std::chrono::steady_clock::now();
+			bool consistent = propagator.assume(decision);
+			stats.seconds += std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+
+			if(!consistent) {
+				stats.conflicts++;
+				Weight max = 0;
+				for(size_t k = 0; k < lits.size(); k++)
+					if(decided[k] != -1)
+						max += weights[k];
+				if(max >= rhs)
+					stats.wrongConflicts++;
+				break;
+			}
+
+			Weight max = 0;
+			for(size_t k = 0; k < lits.size(); k++)
+				if(propagator.value(lits[k]) != -1)
+					max += weights[k];
+			if(max < rhs) {
+				stats.missedConflicts++;
+				break;
+			}
+			for(size_t k = 0; k < lits.size(); k++)
+				if(propagator.value(lits[k]) == 0 && max - weights[k] < rhs)
+					stats.missedImplications++;
+		}
+
+		stats.propagations += propagator.numPropagations() - props_before;
+		propagator.backtrack(0);
+		stats.rounds++;
+	}
+	return stats;
+}
+
+} // namespace encodeuzk
+
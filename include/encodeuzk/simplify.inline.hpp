@@ -0,0 +1,181 @@
+
+namespace encodeuzk {
+
+// maps a DIMACS literal to a dense index: 2 * (var - 1) + sign
+inline size_t denseLiteral(int lit) {
+	return lit > 0 ? 2 * (size_t)(lit - 1) + 1 : 2 * (size_t)(-lit - 1);
+}
+
+// removes tautologies, duplicate literals and duplicate clauses from the formula.
+// if subsumption is true, clauses that are subsumed by other clauses are removed, too.
+// returns the number of clauses that were removed
+template<typename BaseDefs>
+int64_t simplifyFormula(StaticFormula<BaseDefs> &formula, bool subsumption) {
+	std::vector<int> &lits = formula.p_clauses;
+	auto less = [] (int a, int b) {
+		return denseLiteral(a) < denseLiteral(b);
+	};
+
+	// step 1: normalize each clause in place. starts[i] is the position
+	// of the i-th remaining clause; the clauses stay 0-terminated
+	std::vector<size_t> starts;
+	starts.reserve(formula.p_numClauses);
+	size_t out = 0;
+	for(size_t in = 0; in < lits.size(); ) {
+		size_t begin = in;
+		while(lits[in] != 0)
+			in++;
+		std::sort(lits.begin() + begin, lits.begin() + in, less);
+
+		bool tautology = false;
+		size_t start = out;
+		for(size_t i = begin; i < in; i++) {
+			if(out > start && lits[out - 1] == lits[i])
+				continue;
+			if(out > start && lits[out - 1] == -lits[i])
+				tautology = true;
+			lits[out++] = lits[i];
+		}
+		in++;
+
+		if(tautology) {
+			out = start;
+		}else{
+			lits[out++] = 0;
+			starts.push_back(start);
+		}
+	}
+	lits.resize(out);
+
+	auto size = [&] (size_t c) {
+		size_t n = 0;
+		while(lits[starts[c] + n] != 0)
+			n++;
+		return n;
+	};
+	auto equal = [&] (size_t c, size_t d) {
+		for(size_t i = 0; true; i++) {
+			if(lits[starts[c] + i] != lits[starts[d] + i])
+				return false;
+			if(lits[starts[c] + i] == 0)
+				return true;
+		}
+	};
+
+	// step 2: remove duplicate clauses using an open addressing hash table
+	std::vector<char> removed(starts.size(), 0);
+	size_t capacity = 1;
+	while(capacity < 2 * starts.size())
+		capacity *= 2;
+	const size_t empty = std::numeric_limits<size_t>::max();
+	std::vector<size_t> table(capacity, empty);
+	for(size_t c = 0; c < starts.size(); c++) {
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for(size_t i = starts[c]; lits[i] != 0; i++)
+			hash = (hash ^ (uint32_t)lits[i]) * 0x100000001B3ULL;
+		// the low bits of FNV are poorly mixed; apply a finalizer
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+
+		size_t slot = hash & (capacity - 1);
+		while(table[slot] != empty) {
+			if(equal(table[slot], c)) {
+				removed[c] = 1;
+				break;
+			}
+			slot = (slot + 1) & (capacity - 1);
+		}
+		if(!removed[c])
+			table[slot] = c;
+	}
+	std::vector<size_t>().swap(table);
+
+	// step 3: backward subsumption. each clause is checked against the
+	// occurrence list of its least frequent literal
+	if(subsumption) {
+		size_t num_lits = 2 * formula.p_numVariables;
+		std::vector<size_t> occ_begin(num_lits + 1, 0);
+		for(size_t c = 0; c < starts.size(); c++)
+			if(!removed[c])
+				for(size_t i = starts[c]; lits[i] != 0; i++)
+					occ_begin[denseLiteral(lits[i]) + 1]++;
+		for(size_t l = 0; l < num_lits; l++)
+			occ_begin[l + 1] += occ_begin[l];
+		std::vector<size_t> occurs(occ_begin.back());
+		std::vector<size_t> occ_fill(occ_begin.begin(), occ_begin.end() - 1);
+		for(size_t c = 0; c < starts.size(); c++)
+			if(!removed[c])
+				for(size_t i = starts[c]; lits[i] != 0; i++)
+					occurs[occ_fill[denseLiteral(lits[i])]++] = c;
+		std::vector<size_t>().swap(occ_fill);
+
+		std::vector<size_t> sizes(starts.size());
+		std::vector<uint64_t> signatures(starts.size(), 0);
+		std::vector<size_t> order;
+		for(size_t c = 0; c < starts.size(); c++) {
+			if(removed[c])
+				continue;
+			sizes[c] = size(c);
+			for(size_t i = starts[c]; lits[i] != 0; i++)
+				signatures[c] |= uint64_t(1) << (denseLiteral(lits[i]) % 64);
+			order.push_back(c);
+		}
+		std::sort(order.begin(), order.end(), [&] (size_t c, size_t d) {
+			return sizes[c] < sizes[d];
+		});
+
+		std::vector<char> marks(num_lits, 0);
+		for(auto it = order.begin(); it != order.end(); ++it) {
+			size_t c = *it;
+			if(removed[c] || sizes[c] == 0)
+				continue;
+
+			size_t pivot = denseLiteral(lits[starts[c]]);
+			for(size_t i = starts[c]; lits[i] != 0; i++) {
+				size_t l = denseLiteral(lits[i]);
+				if(occ_begin[l + 1] - occ_begin[l] < occ_begin[pivot + 1] - occ_begin[pivot])
+					pivot = l;
+				marks[l] = 1;
+			}
+
+			for(size_t j = occ_begin[pivot]; j < occ_begin[pivot + 1]; j++) {
+				size_t d = occurs[j];
+				// clauses of equal size are either duplicates or incomparable
+				if(removed[d] || sizes[d] <= sizes[c]
+						|| (signatures[c] & ~signatures[d]) != 0)
+					continue;
+				size_t hits = 0;
+				for(size_t i = starts[d]; lits[i] != 0; i++)
+					hits += marks[denseLiteral(lits[i])];
+				if(hits == sizes[c])
+					removed[d] = 1;
+			}
+
+			for(size_t i = starts[c]; lits[i] != 0; i++)
+				marks[denseLiteral(lits[i])] = 0;
+		}
+	}
+
+	// compact the remaining clauses
+	out = 0;
+	int64_t num_removed = 0;
+	for(size_t c = 0; c < starts.size(); c++) {
+		if(removed[c]) {
+			num_removed++;
+			continue;
+		}
+		size_t i = starts[c];
+		while(lits[i] != 0)
+			lits[out++] = lits[i++];
+		lits[out++] = 0;
+	}
+	lits.resize(out);
+
+	num_removed += formula.p_numClauses - starts.size();
+	formula.p_numClauses -= num_removed;
+	return num_removed;
+}
+
+} // namespace encodeuzk
+
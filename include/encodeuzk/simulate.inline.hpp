@@ -0,0 +1,195 @@
+
+namespace encodeuzk {
+
+// evaluates a circuit on 64 assignments at once: bit i of each word
+// belongs to the i-th assignment. free variables that are not constant
+// are treated like inputs
+template<typename BaseDefs>
+class CircuitSimulator {
+public:
+	typedef typename CircuitDefs<BaseDefs>::Variable Variable;
+	typedef typename CircuitDefs<BaseDefs>::Literal Literal;
+
+	CircuitSimulator(const Circuit<BaseDefs> &circuit)
+			: p_circuit(circuit), p_values(circuit.numVariables(), 0) {
+		std::vector<Variable> roots;
+		for(size_t i = 0; i < circuit.numVariables(); i++)
+			roots.push_back(Variable::fromIndex(i));
+		p_order = circuitPostOrder(circuit, roots);
+	}
+
+	void setInput(Variable var, uint64_t word) {
+		p_values[var.getIndex()] = word;
+	}
+
+	void simulate() {
+		for(auto it = p_order.begin(); it != p_order.end(); ++it) {
+			uint64_t &word = p_values[it->getIndex()];
+			switch(p_circuit.gate(*it)) {
+			case CircuitGate::Constant:
+				word = ~uint64_t(0);
+				break;
+			case CircuitGate::Input:
+			case CircuitGate::Free:
+				break;
+			case CircuitGate::Alias:
+				word = value(*p_circuit.faninBegin(*it));
+				break;
+			case CircuitGate::And:
+				word = ~uint64_t(0);
+				for(auto jt = p_circuit.faninBegin(*it); jt != p_circuit.faninEnd(*it); ++jt)
+					word &= value(*jt);
+				break;
+			case CircuitGate::Xor:
+				word = 0;
+				for(auto jt = p_circuit.faninBegin(*it); jt != p_circuit.faninEnd(*it); ++jt)
+					word ^= value(*jt);
+				break;
+			}
+		}
+	}
+
+	uint64_t value(Literal lit) const {
+		uint64_t word = p_values[lit.variable().getIndex()];
+		return lit.isOneLiteral() ? word : ~word;
+	}
+
+	// returns the assignments that satisfy all clauses recorded in the circuit
+	uint64_t satisfied() const {
+		uint64_t result = ~uint64_t(0);
+		for(size_t i = 0; i < p_circuit.numConstraints(); i++) {
+			uint64_t clause = 0;
+			for(auto it = p_circuit.constraintBegin(i); it != p_circuit.constraintEnd(i); ++it)
+				clause |= value(*it);
+			result &= clause;
+		}
+		return result;
+	}
+
+private:
+	const Circuit<BaseDefs> &p_circuit;
+	std::vector<Variable> p_order;
+	std::vector<uint64_t> p_values;
+};
+
+// generates the input words for one round of validation. all 2^n assignments
+// are enumerated if they fit into the given number of rounds; otherwise the
+// assignments are drawn at random. returns the mask of valid assignments
+template<typename Generator>
+uint64_t simulationRound(std::vector<uint64_t> &words, uint64_t round,
+		uint64_t rounds, Generator &generator) {
+	size_t n = words.size();
+	if(n < 64 && (uint64_t(1) << n) <= 64 * rounds) {
+		uint64_t total = uint64_t(1) << n;
+		uint64_t mask = 0;
+		for(size_t i = 0; i < n; i++)
+			words[i] = 0;
+		for(uint64_t lane = 0; lane < 64; lane++) {
+			uint64_t assignment = 64 * round + lane;
+			if(assignment >= total)
+				break;
+			mask |= uint64_t(1) << lane;
+			for(size_t i = 0; i < n; i++)
+				words[i] |= ((assignment >> i) & 1) << lane;
+		}
+		return mask;
+	}
+
+	for(size_t i = 0; i < n; i++)
+		words[i] = generator();
+	return ~uint64_t(0);
+}
+
+// checks that computePwSort sorts n inputs on 64 * rounds assignments.
+// returns the number of assignments that are not sorted correctly
+template<typename BaseDefs, typename MergePolicy = PairwiseMergePolicy>
+uint64_t validatePwSort(size_t n, uint64_t rounds, uint64_t seed) {
+	typedef typename CircuitDefs<BaseDefs>::Literal Literal;
+
+	Circuit<BaseDefs> circuit;
+	CircuitAllocator<BaseDefs> allocator(circuit);
+	CircuitEmitter<BaseDefs> emitter(circuit);
+
+	std::vector<Literal> ins;
+	for(size_t i = 0; i < n; i++)
+		ins.push_back(circuit.addInput().oneLiteral());
+	std::vector<Literal> outs
+			= computePwSort<MergePolicy>(allocator, emitter, ins, circuit.constant(false));
+	assert(outs.size() == n);
+
+	CircuitSimulator<BaseDefs> simulator(circuit);
+	std::mt19937_64 generator(seed);
+	std::vector<uint64_t> words(n);
+	uint64_t failures = 0;
+	for(uint64_t round = 0; round < rounds; round++) {
+		uint64_t mask = simulationRound(words, round, rounds, generator);
+		if(!mask)
+			break;
+		for(size_t i = 0; i < n; i++)
+			simulator.setInput(ins[i].variable(), words[i]);
+		simulator.simulate();
+
+		// outs[j] must be set iff more than j inputs are set
+		uint64_t wrong = ~simulator.satisfied();
+		for(uint64_t lane = 0; lane < 64; lane++) {
+			size_t count = 0;
+			for(size_t i = 0; i < n; i++)
+				count += (words[i] >> lane) & 1;
+			for(size_t j = 0; j < n; j++)
+				if(((simulator.value(outs[j]) >> lane) & 1) != (count > j))
+					wrong |= uint64_t(1) << lane;
+		}
+		failures += popCount(wrong & mask);
+	}
+	return failures;
+}
+
+// checks computeSorterNetworkGe for the constraint sum weights[i] * x[i] >= rhs
+// on 64 * rounds assignments. returns the number of assignments where the
+// result of the network differs from the weighted sum
+template<typename BaseDefs, typename MergePolicy = PairwiseMergePolicy, typename Weight>
+uint64_t validateSorterNetworkGe(const std::vector<Weight> &weights,
+		const std::vector<int> &base, Weight rhs, uint64_t rounds, uint64_t seed) {
+	typedef typename CircuitDefs<BaseDefs>::Literal Literal;
+
+	Circuit<BaseDefs> circuit;
+	CircuitAllocator<BaseDefs> allocator(circuit);
+	CircuitEmitter<BaseDefs> emitter(circuit);
+
+	size_t n = weights.size();
+	std::vector<Literal> ins;
+	for(size_t i = 0; i < n; i++)
+		ins.push_back(circuit.addInput().oneLiteral());
+	SorterNetwork<Literal> network
+			= computeSorterNetwork<MergePolicy>(allocator, emitter, ins, weights, base);
+	Literal ge = computeSorterNetworkGe(allocator, emitter, network,
+			base, convertBase(rhs, base));
+
+	CircuitSimulator<BaseDefs> simulator(circuit);
+	std::mt19937_64 generator(seed);
+	std::vector<uint64_t> words(n);
+	uint64_t failures = 0;
+	for(uint64_t round = 0; round < rounds; round++) {
+		uint64_t mask = simulationRound(words, round, rounds, generator);
+		if(!mask)
+			break;
+		for(size_t i = 0; i < n; i++)
+			simulator.setInput(ins[i].variable(), words[i]);
+		simulator.simulate();
+
+		uint64_t wrong = ~simulator.satisfied();
+		for(uint64_t lane = 0; lane < 64; lane++) {
+			Weight sum = 0;
+			for(size_t i = 0; i < n; i++)
+				if((words[i] >> lane) & 1)
+					sum += weights[i];
+			if(((simulator.value(ge) >> lane) & 1) != (sum >= rhs))
+				wrong |= uint64_t(1) << lane;
+		}
+		failures += popCount(wrong & mask);
+	}
+	return failures;
+}
+
+} // namespace encodeuzk
+
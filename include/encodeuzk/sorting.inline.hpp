@@ -7,15 +7,19 @@ void forceComparator(VarAllocator &allocator, ClauseEmitter &emitter,
 		typename ClauseEmitter::Literal x2,
 		typename ClauseEmitter::Literal y1,
 		typename ClauseEmitter::Literal y2) {
-	// these clauses represent min(x1, x2) <= y1, max(x1, x2) <= y2
-	emit(emitter, { x1.inverse(), y1 });
-	emit(emitter, { x2.inverse(), y1 });
-	emit(emitter, { x1.inverse(), x2.inverse(), y2 });
-
-	// these clauses represent min(x1, x2) >= y1, max(x1, x2) >= y2
-	emit(emitter, { y2.inverse(), x1 });
-	emit(emitter, { y2.inverse(), x2 });
-	emit(emitter, { y1.inverse(), x1, x2 });
+	const typename ClauseEmitter::Literal literals[] = {
+		// these clauses represent min(x1, x2) <= y1, max(x1, x2) <= y2
+		x1.inverse(), y1,
+		x2.inverse(), y1,
+		x1.inverse(), x2.inverse(), y2,
+
+		// these clauses represent min(x1, x2) >= y1, max(x1, x2) >= y2
+		y2.inverse(), x1,
+		y2.inverse(), x2,
+		y1.inverse(), x1, x2
+	};
+	static const unsigned int sizes[] = { 2, 2, 3, 2, 2, 3 };
+	emitBlock(emitter, literals, sizes);
 }
 
 template<typename VarAllocator, typename ClauseEmitter>
@@ -28,10 +32,13 @@ computePwSplit(VarAllocator &allocator, ClauseEmitter &emitter,
 
 	std::vector<typename ClauseEmitter::Literal> outs_a;
 	std::vector<typename ClauseEmitter::Literal> outs_b;
+	outs_a.reserve(ins.size() / 2);
+	outs_b.reserve(ins.size() / 2);
 
+	auto temps = allocateRange(allocator, ins.size());
 	for(int i = 0; i < ins.size() / 2; i++) {
-		typename ClauseEmitter::Literal a = allocator.allocate().oneLiteral();
-		typename ClauseEmitter::Literal b = allocator.allocate().oneLiteral();
+		typename ClauseEmitter::Literal a = temps[2 * i].oneLiteral();
+		typename ClauseEmitter::Literal b = temps[2 * i + 1].oneLiteral();
 		outs_a.push_back(a);
 		outs_b.push_back(b);
 		forceComparator(allocator, emitter, ins[2 * i], ins[2 * i + 1], a, b);
@@ -40,8 +47,172 @@ computePwSplit(VarAllocator &allocator, ClauseEmitter &emitter,
 	return std::make_pair(outs_a, outs_b);
 }
 
+// strategies for merging two sorted sequences
+enum class MergeStrategy {
+	// recursive pairwise (odd-even) merging
+	Pairwise,
+	// one clause per combination of inputs; depth one but quadratic size
+	Direct,
+	// a bitonic merger built from half-cleaners
+	Bitonic
+};
+
+// merge policies choose the strategy for each recursion level
+// of computePwSort and computePwMerge based on the size of the sequences
+// that are merged. as direct and bitonic merging accept any two sorted
+// sequences, computePwSort splits its inputs without comparators for them
+struct PairwiseMergePolicy {
+	static MergeStrategy choose(size_t n) {
+		return MergeStrategy::Pairwise;
+	}
+};
+
+struct DirectMergePolicy {
+	static MergeStrategy choose(size_t n) {
+		return MergeStrategy::Direct;
+	}
+};
+
+struct BitonicMergePolicy {
+	static MergeStrategy choose(size_t n) {
+		return MergeStrategy::Bitonic;
+	}
+};
+
+// recurses like the pairwise merger but switches to direct merging once
+// the inputs are small, in the style of the mixed networks of Abio et al.
+template<size_t Threshold>
+struct HybridMergePolicy {
+	static MergeStrategy choose(size_t n) {
+		return n <= Threshold ? MergeStrategy::Direct : MergeStrategy::Pairwise;
+	}
+};
+
+// merges two sorted sequences directly: output k (counting from zero) is
+// true iff at least k + 1 inputs are true. trailing occurrences of
+// null_lit are ignored. produces a.size() + b.size() outputs
+template<typename VarAllocator, typename ClauseEmitter>
+std::vector<typename ClauseEmitter::Literal>
+computeDirectMerge(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &a,
+		const std::vector<typename ClauseEmitter::Literal> &b,
+		typename ClauseEmitter::Literal null_lit) {
+	size_t p = a.size();
+	while(p > 0 && a[p - 1] == null_lit)
+		p--;
+	size_t q = b.size();
+	while(q > 0 && b[q - 1] == null_lit)
+		q--;
+
+	std::vector<typename ClauseEmitter::Literal> outs;
+	outs.reserve(a.size() + b.size());
+	auto temps = allocateRange(allocator, p + q);
+	for(size_t k = 0; k < p + q; k++)
+		outs.push_back(temps[k].oneLiteral());
+
+	std::vector<typename ClauseEmitter::Literal> literals;
+	std::vector<unsigned int> sizes;
+	for(size_t i = 0; i <= p; i++) {
+		for(size_t j = 0; j <= q; j++) {
+			// i inputs of a and j inputs of b are true: at least i + j outputs are true
+			if(i + j > 0) {
+				if(i > 0)
+					literals.push_back(a[i - 1].inverse());
+				if(j > 0)
+					literals.push_back(b[j - 1].inverse());
+				literals.push_back(outs[i + j - 1]);
+				sizes.push_back((i > 0) + (j > 0) + 1);
+			}
+
+			// at most i inputs of a and j inputs of b are true: at most i + j outputs are true
+			if(i + j < p + q) {
+				literals.push_back(outs[i + j].inverse());
+				if(i < p)
+					literals.push_back(a[i]);
+				if(j < q)
+					literals.push_back(b[j]);
+				sizes.push_back((i < p) + (j < q) + 1);
+			}
+		}
+	}
+	emitBlock(emitter, literals.data(), sizes.data(), sizes.size());
+
+	while(outs.size() < a.size() + b.size())
+		outs.push_back(null_lit);
+	return outs;
+}
+
+// sorts a bitonic sequence whose size is a power of two
 template<typename VarAllocator, typename ClauseEmitter>
 std::vector<typename ClauseEmitter::Literal>
+computeBitonicClean(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &ins,
+		typename ClauseEmitter::Literal null_lit) {
+	if(ins.size() <= 1)
+		return ins;
+	size_t half = ins.size() / 2;
+
+	// comparators with a null_lit input are folded: the other input is the maximum
+	size_t n_comparators = 0;
+	for(size_t i = 0; i < half; i++)
+		if(!(ins[i] == null_lit) && !(ins[i + half] == null_lit))
+			n_comparators++;
+
+	// the half-cleaner moves the larger element of each pair to the first half
+	std::vector<typename ClauseEmitter::Literal> upper;
+	std::vector<typename ClauseEmitter::Literal> lower;
+	upper.reserve(half);
+	lower.reserve(half);
+	auto temps = allocateRange(allocator, 2 * n_comparators);
+	size_t t = 0;
+	for(size_t i = 0; i < half; i++) {
+		typename ClauseEmitter::Literal x = ins[i];
+		typename ClauseEmitter::Literal y = ins[i + half];
+		if(x == null_lit || y == null_lit) {
+			upper.push_back(x == null_lit ? y : x);
+			lower.push_back(null_lit);
+			continue;
+		}
+		upper.push_back(temps[t++].oneLiteral());
+		lower.push_back(temps[t++].oneLiteral());
+		forceComparator(allocator, emitter, x, y, upper.back(), lower.back());
+	}
+
+	std::vector<typename ClauseEmitter::Literal> outs
+			= computeBitonicClean(allocator, emitter, upper, null_lit);
+	std::vector<typename ClauseEmitter::Literal> lower_outs
+			= computeBitonicClean(allocator, emitter, lower, null_lit);
+	outs.insert(outs.end(), lower_outs.begin(), lower_outs.end());
+	return outs;
+}
+
+// merges two sorted sequences with a bitonic merger.
+// produces a.size() + b.size() outputs
+template<typename VarAllocator, typename ClauseEmitter>
+std::vector<typename ClauseEmitter::Literal>
+computeBitonicMerge(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &a,
+		const std::vector<typename ClauseEmitter::Literal> &b,
+		typename ClauseEmitter::Literal null_lit) {
+	size_t m = 1;
+	while(m < a.size() || m < b.size())
+		m *= 2;
+
+	// a descending sequence followed by an ascending one is bitonic
+	std::vector<typename ClauseEmitter::Literal> ins(a.begin(), a.end());
+	ins.resize(m, null_lit);
+	ins.resize(2 * m - b.size(), null_lit);
+	ins.insert(ins.end(), b.rbegin(), b.rend());
+
+	std::vector<typename ClauseEmitter::Literal> outs
+			= computeBitonicClean(allocator, emitter, ins, null_lit);
+	outs.resize(a.size() + b.size());
+	return outs;
+}
+
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
+std::vector<typename ClauseEmitter::Literal>
 computePwMerge(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &a,
 		const std::vector<typename ClauseEmitter::Literal> &b,
@@ -55,6 +226,16 @@ computePwMerge(VarAllocator &allocator, ClauseEmitter &emitter,
 		outs.push_back(b.front());
 		return outs;
 	}
+
+	switch(MergePolicy::choose(a.size())) {
+	case MergeStrategy::Direct:
+		return computeDirectMerge(allocator, emitter, a, b, null_lit);
+	case MergeStrategy::Bitonic:
+		return computeBitonicMerge(allocator, emitter, a, b, null_lit);
+	case MergeStrategy::Pairwise:
+		break;
+	}
+
 	if(a.size() % 2 == 1) {
 		std::vector<typename ClauseEmitter::Literal> new_a;
 		std::vector<typename ClauseEmitter::Literal> new_b;
@@ -66,7 +247,7 @@ computePwMerge(VarAllocator &allocator, ClauseEmitter &emitter,
 		new_b.push_back(null_lit);
 
 		std::vector<typename ClauseEmitter::Literal> outs
-				= computePwMerge(allocator, emitter, new_a, new_b, null_lit);
+				= computePwMerge<MergePolicy>(allocator, emitter, new_a, new_b, null_lit);
 		outs.pop_back();
 		outs.pop_back();
 		return outs;
@@ -89,9 +270,9 @@ computePwMerge(VarAllocator &allocator, ClauseEmitter &emitter,
 	}
 
 	std::vector<typename ClauseEmitter::Literal> even_temps
-			= computePwMerge(allocator, emitter, even_a, even_b, null_lit);
+			= computePwMerge<MergePolicy>(allocator, emitter, even_a, even_b, null_lit);
 	std::vector<typename ClauseEmitter::Literal> odd_temps
-			= computePwMerge(allocator, emitter, odd_a, odd_b, null_lit);
+			= computePwMerge<MergePolicy>(allocator, emitter, odd_a, odd_b, null_lit);
 	assert(even_temps.size() == a.size());
 	assert(odd_temps.size() == a.size());
 
@@ -99,26 +280,40 @@ computePwMerge(VarAllocator &allocator, ClauseEmitter &emitter,
 	int n_merge = a.size() - 1;
 	
 	std::vector<typename ClauseEmitter::Literal> outs;
+	outs.reserve(2 * a.size());
 
-	outs.push_back(even_temps.front());
+	// comparators with a null_lit input are folded: the other input is the maximum
+	int n_comparators = 0;
 	for(int i = 0; i < n_merge; i++)
-		outs.push_back(allocator.allocate().oneLiteral());
-	for(int i = 0; i < n_merge; i++)
-		outs.push_back(allocator.allocate().oneLiteral());
+		if(!(even_temps[i + 1] == null_lit) && !(odd_temps[i] == null_lit))
+			n_comparators++;
+
+	auto temps = allocateRange(allocator, 2 * n_comparators);
+	int t = 0;
+	outs.push_back(even_temps.front());
+	for(int i = 0; i < n_merge; i++) {
+		typename ClauseEmitter::Literal x = even_temps[i + 1];
+		typename ClauseEmitter::Literal y = odd_temps[i];
+		if(x == null_lit || y == null_lit) {
+			outs.push_back(x == null_lit ? y : x);
+			outs.push_back(null_lit);
+			continue;
+		}
+		outs.push_back(temps[t++].oneLiteral());
+		outs.push_back(temps[t++].oneLiteral());
+		forceComparator(allocator, emitter, x, y, outs[2 * i + 1], outs[2 * i + 2]);
+	}
 	outs.push_back(odd_temps.back());
 	assert(outs.size() == 2 * a.size());
 
-	for(unsigned int i = 0; i < n_merge; i++)
-		forceComparator(allocator, emitter, even_temps[i + 1], odd_temps[i],
-				outs[2 * i + 1], outs[2 * i + 2]);
-
 	// additional clauses to improve propagation
 //	for(int i = 0; i < outs.size() - 1; i++)
 //		emit(emitter, { outs[i], outs[i + 1].inverse() });
 	return outs;
 }
 
-template<typename VarAllocator, typename ClauseEmitter>
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
 std::vector<typename ClauseEmitter::Literal>
 computePwSort(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &ins,
@@ -130,6 +325,23 @@ computePwSort(VarAllocator &allocator, ClauseEmitter &emitter,
 		outs.push_back(ins[0]);
 		return outs;
 	}
+
+	size_t half = ins.size() / 2;
+	MergeStrategy strategy = MergePolicy::choose(ins.size() - half);
+	if(strategy != MergeStrategy::Pairwise) {
+		std::vector<typename ClauseEmitter::Literal> outs_a
+				= computePwSort<MergePolicy>(allocator, emitter,
+				std::vector<typename ClauseEmitter::Literal>(ins.begin(), ins.begin() + half),
+				null_lit);
+		std::vector<typename ClauseEmitter::Literal> outs_b
+				= computePwSort<MergePolicy>(allocator, emitter,
+				std::vector<typename ClauseEmitter::Literal>(ins.begin() + half, ins.end()),
+				null_lit);
+		if(strategy == MergeStrategy::Direct)
+			return computeDirectMerge(allocator, emitter, outs_a, outs_b, null_lit);
+		return computeBitonicMerge(allocator, emitter, outs_a, outs_b, null_lit);
+	}
+
 	if(ins.size() % 2 == 1) {
 		std::vector<typename ClauseEmitter::Literal> new_ins;
 		for(int i = 0; i < ins.size(); i++)
@@ -137,7 +349,7 @@ computePwSort(VarAllocator &allocator, ClauseEmitter &emitter,
 		new_ins.push_back(null_lit);
 
 		std::vector<typename ClauseEmitter::Literal> outs
-				= computePwSort(allocator, emitter, new_ins, null_lit);
+				= computePwSort<MergePolicy>(allocator, emitter, new_ins, null_lit);
 		outs.pop_back();
 		return outs;
 	}
@@ -147,13 +359,14 @@ computePwSort(VarAllocator &allocator, ClauseEmitter &emitter,
 			= computePwSplit(allocator, emitter, ins, null_lit);
 		
 	std::vector<typename ClauseEmitter::Literal> outs_a
-			= computePwSort(allocator, emitter, parts.first, null_lit);
+			= computePwSort<MergePolicy>(allocator, emitter, parts.first, null_lit);
 	std::vector<typename ClauseEmitter::Literal> outs_b
-			= computePwSort(allocator, emitter, parts.second, null_lit);
-	return computePwMerge(allocator, emitter, outs_a, outs_b, null_lit);
+			= computePwSort<MergePolicy>(allocator, emitter, parts.second, null_lit);
+	return computePwMerge<MergePolicy>(allocator, emitter, outs_a, outs_b, null_lit);
 }
 
-template<typename VarAllocator, typename ClauseEmitter>
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
 void forceAtLeastPw(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &ins, int weight,
 		typename ClauseEmitter::Literal null_lit) {
@@ -165,11 +378,12 @@ void forceAtLeastPw(VarAllocator &allocator, ClauseEmitter &emitter,
 	}
 	
 	std::vector<typename ClauseEmitter::Literal> outs
-			= computePwSort(allocator, emitter, ins, null_lit);
+			= computePwSort<MergePolicy>(allocator, emitter, ins, null_lit);
 	forceTrue(allocator, emitter, outs[weight - 1]);
 }
 
-template<typename VarAllocator, typename ClauseEmitter>
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
 void forceAtMostPw(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &ins, int weight,
 		typename ClauseEmitter::Literal null_lit) {
@@ -181,7 +395,7 @@ void forceAtMostPw(VarAllocator &allocator, ClauseEmitter &emitter,
 		return;
 	
 	std::vector<typename ClauseEmitter::Literal> outs
-			= computePwSort(allocator, emitter, ins, null_lit);
+			= computePwSort<MergePolicy>(allocator, emitter, ins, null_lit);
 	forceFalse(allocator, emitter, outs[weight]);
 }
 
@@ -191,8 +405,121 @@ using SorterLits = std::vector<Literal>;
 template<typename Literal>
 using SorterNetwork = std::vector<SorterLits<Literal>>;
 
-template<typename VarAllocator, typename ClauseEmitter,
-		typename Weight>
+// merges two sorted sequences of arbitrary length. a layer of comparators
+// makes the first sequence dominate the second one elementwise,
+// which is the precondition of computePwMerge. a much shorter sequence
+// is merged directly instead
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
+SorterLits<typename ClauseEmitter::Literal>
+computeMerge(VarAllocator &allocator, ClauseEmitter &emitter,
+		const SorterLits<typename ClauseEmitter::Literal> &a,
+		const SorterLits<typename ClauseEmitter::Literal> &b,
+		typename ClauseEmitter::Literal null_lit) {
+	if(a.size() == 0)
+		return b;
+	if(b.size() == 0)
+		return a;
+
+	const SorterLits<typename ClauseEmitter::Literal> &longer = a.size() < b.size() ? b : a;
+	size_t n = longer.size();
+	size_t m = std::min(a.size(), b.size());
+
+	// a short sequence is merged directly in O(m * n) clauses,
+	// the pairwise merger below needs O(n log n) clauses for any m
+	size_t log_n = 0;
+	while((size_t(1) << log_n) < n)
+		log_n++;
+	if(m < log_n)
+		return computeDirectMerge(allocator, emitter, a, b, null_lit);
+
+	std::vector<typename ClauseEmitter::Literal> max_lits;
+	std::vector<typename ClauseEmitter::Literal> min_lits;
+	max_lits.reserve(n);
+	min_lits.reserve(n);
+
+	auto temps = allocateRange(allocator, 2 * m);
+	for(size_t i = 0; i < m; i++) {
+		max_lits.push_back(temps[2 * i].oneLiteral());
+		min_lits.push_back(temps[2 * i + 1].oneLiteral());
+		forceComparator(allocator, emitter, a[i], b[i], max_lits[i], min_lits[i]);
+	}
+	for(size_t i = m; i < n; i++) {
+		max_lits.push_back(longer[i]);
+		min_lits.push_back(null_lit);
+	}
+
+	// the last outputs are always zero as only a.size() + b.size() inputs are non-zero
+	std::vector<typename ClauseEmitter::Literal> outs
+			= computePwMerge<MergePolicy>(allocator, emitter, max_lits, min_lits, null_lit);
+	outs.resize(a.size() + b.size());
+	return outs;
+}
+
+// merges any number of sorted sequences. the two shortest sequences
+// are merged first, similar to the construction of a Huffman tree
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
+SorterLits<typename ClauseEmitter::Literal>
+computeMergeN(VarAllocator &allocator, ClauseEmitter &emitter,
+		std::vector<SorterLits<typename ClauseEmitter::Literal>> seqs,
+		typename ClauseEmitter::Literal null_lit) {
+	typedef std::pair<size_t, size_t> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	for(size_t i = 0; i < seqs.size(); i++)
+		if(seqs[i].size() > 0)
+			queue.push(std::make_pair(seqs[i].size(), i));
+	if(queue.empty())
+		return SorterLits<typename ClauseEmitter::Literal>();
+
+	while(queue.size() > 1) {
+		size_t i = queue.top().second;
+		queue.pop();
+		size_t j = queue.top().second;
+		queue.pop();
+
+		seqs[i] = computeMerge<MergePolicy>(allocator, emitter, seqs[i], seqs[j], null_lit);
+		SorterLits<typename ClauseEmitter::Literal>().swap(seqs[j]);
+		queue.push(std::make_pair(seqs[i].size(), i));
+	}
+	return seqs[queue.top().second];
+}
+
+// sorts the unary sequence that contains each lits[i] multiplicities[i] times.
+// literals are not replicated before sorting: the literals of each multiplicity
+// are sorted once, each output is repeated and the results are merged
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter>
+SorterLits<typename ClauseEmitter::Literal>
+computeWeightedSort(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits,
+		const std::vector<int> &multiplicities,
+		typename ClauseEmitter::Literal null_lit) {
+	assert(lits.size() == multiplicities.size());
+
+	std::map<int, std::vector<typename ClauseEmitter::Literal>> groups;
+	for(size_t i = 0; i < lits.size(); i++)
+		if(multiplicities[i] > 0)
+			groups[multiplicities[i]].push_back(lits[i]);
+
+	std::vector<SorterLits<typename ClauseEmitter::Literal>> seqs;
+	for(auto it = groups.begin(); it != groups.end(); ++it) {
+		std::vector<typename ClauseEmitter::Literal> sorted
+				= computePwSort<MergePolicy>(allocator, emitter, it->second, null_lit);
+
+		SorterLits<typename ClauseEmitter::Literal> seq;
+		seq.reserve(sorted.size() * it->first);
+		for(size_t j = 0; j < sorted.size(); j++)
+			for(int m = 0; m < it->first; m++)
+				seq.push_back(sorted[j]);
+		seqs.push_back(seq);
+	}
+
+	return computeMergeN<MergePolicy>(allocator, emitter, seqs, null_lit);
+}
+
+template<typename MergePolicy = PairwiseMergePolicy,
+		typename VarAllocator, typename ClauseEmitter, typename Weight>
 SorterNetwork<typename ClauseEmitter::Literal>
 computeSorterNetwork(VarAllocator &allocator, ClauseEmitter &emitter,
 		const std::vector<typename ClauseEmitter::Literal> &lits,
@@ -201,25 +528,31 @@ computeSorterNetwork(VarAllocator &allocator, ClauseEmitter &emitter,
 	typename ClauseEmitter::Literal null_lit = allocator.allocate().oneLiteral();
 	emit(emitter, { null_lit.inverse() });
 	
+	std::vector<std::vector<int>> digits;
+	for(size_t i = 0; i < lits.size(); i++)
+		digits.push_back(convertBase(weights[i], base));
+
 	SorterNetwork<typename ClauseEmitter::Literal> sorters;
 
 	for(int k = 0; k < base.size(); k++) {
-		std::vector<typename ClauseEmitter::Literal> ins;
+		std::vector<SorterLits<typename ClauseEmitter::Literal>> seqs;
 
 		// add carry bits from previous sorter as input
 		if(k > 0) {
+			SorterLits<typename ClauseEmitter::Literal> carries;
 			for(int j = base[k] - 1; j < sorters.back().size(); j += base[k])
-				ins.push_back(sorters.back()[j]);
+				carries.push_back(sorters.back()[j]);
+			seqs.push_back(carries);
 		}
 
-		for(int i = 0; i < lits.size(); i++) {
-			std::vector<int> weight = convertBase(weights[i], base);
-			for(int j = 0; j < weight[k]; j++)
-				ins.push_back(lits[i]);
-		}
+		std::vector<int> multiplicities;
+		for(size_t i = 0; i < lits.size(); i++)
+			multiplicities.push_back(digits[i][k]);
+		seqs.push_back(computeWeightedSort<MergePolicy>(allocator, emitter,
+				lits, multiplicities, null_lit));
 
 		std::vector<typename ClauseEmitter::Literal> outs
-				= computePwSort(allocator, emitter, ins, null_lit);
+				= computeMergeN<MergePolicy>(allocator, emitter, seqs, null_lit);
 		std::cout << "c Size of sorter " << k << ": " << outs.size() << std::endl;
 		sorters.push_back(outs);
 	}
@@ -227,6 +560,116 @@ computeSorterNetwork(VarAllocator &allocator, ClauseEmitter &emitter,
 	return sorters;
 }
 
+// the outputs of a digit sorter grow from old_outs to new_outs by at most
+// grown literals. produces the carries that are passed on in addition to the
+// ones of old_outs: output t - 1 is true iff new_outs has at least t carries
+// more than old_outs. costs O(old_outs.size() / base) clauses per output
+template<typename VarAllocator, typename ClauseEmitter>
+SorterLits<typename ClauseEmitter::Literal>
+computeCarryIncrease(VarAllocator &allocator, ClauseEmitter &emitter,
+		const SorterLits<typename ClauseEmitter::Literal> &old_outs,
+		const SorterLits<typename ClauseEmitter::Literal> &new_outs,
+		int base, size_t grown) {
+	SorterLits<typename ClauseEmitter::Literal> old_carries;
+	for(size_t j = base - 1; j < old_outs.size(); j += base)
+		old_carries.push_back(old_outs[j]);
+	SorterLits<typename ClauseEmitter::Literal> new_carries;
+	for(size_t j = base - 1; j < new_outs.size(); j += base)
+		new_carries.push_back(new_outs[j]);
+	if(old_carries.empty())
+		return new_carries;
+
+	// the number of carries grows by at most this much
+	size_t increase = (grown + base - 1) / base;
+
+	SorterLits<typename ClauseEmitter::Literal> outs;
+	for(size_t t = 1; t <= increase; t++) {
+		// there are at most j old carries and at least j + t new carries
+		std::vector<typename ClauseEmitter::Literal> disjunction;
+		for(size_t j = 0; j <= old_carries.size() && j + t <= new_carries.size(); j++) {
+			if(j == old_carries.size()) {
+				disjunction.push_back(new_carries[j + t - 1]);
+			}else{
+				disjunction.push_back(computeAnd(allocator, emitter,
+						old_carries[j].inverse(), new_carries[j + t - 1]));
+			}
+		}
+		if(disjunction.empty())
+			break;
+		outs.push_back(computeOrN(allocator, emitter,
+				disjunction.begin(), disjunction.end()));
+	}
+	return outs;
+}
+
+// a sorter network that can absorb additional weighted literals.
+// new literals are sorted separately per digit, together with the carries
+// that the previous digit passes on in addition to its earlier ones
+// (see computeCarryIncrease), and merged into the digit sorter. so the cost
+// of an extension grows with the number of new literals and linearly with
+// the size of the network. the base never changes.
+// literals that computeSorterNetworkGe produced for an earlier network()
+// remain valid for the sum of the literals that were added up to then
+template<typename Literal, typename MergePolicy = PairwiseMergePolicy>
+class IncrementalSorterNetwork {
+public:
+	IncrementalSorterNetwork(const std::vector<int> &base)
+			: p_base(base), p_hasNullLit(false), p_network(base.size()) { }
+
+	const std::vector<int> &base() const {
+		return p_base;
+	}
+
+	const SorterNetwork<Literal> &network() const {
+		return p_network;
+	}
+
+	template<typename VarAllocator, typename ClauseEmitter, typename Weight>
+	void extend(VarAllocator &allocator, ClauseEmitter &emitter,
+			const std::vector<Literal> &lits, const std::vector<Weight> &weights) {
+		assert(lits.size() == weights.size());
+		if(!p_hasNullLit) {
+			p_nullLit = allocator.allocate().oneLiteral();
+			emit(emitter, { p_nullLit.inverse() });
+			p_hasNullLit = true;
+		}
+
+		std::vector<std::vector<int>> digits;
+		for(size_t i = 0; i < lits.size(); i++)
+			digits.push_back(convertBase(weights[i], p_base));
+
+		// the outputs of the previous digit before this extension
+		SorterLits<Literal> previous;
+		// the number of outputs the previous digit gained
+		size_t grown = 0;
+		for(size_t k = 0; k < p_base.size(); k++) {
+			std::vector<int> multiplicities;
+			for(size_t i = 0; i < lits.size(); i++)
+				multiplicities.push_back(digits[i][k]);
+			SorterLits<Literal> added = computeWeightedSort<MergePolicy>(allocator, emitter,
+					lits, multiplicities, p_nullLit);
+			if(k > 0 && grown > 0) {
+				SorterLits<Literal> carries = computeCarryIncrease(allocator, emitter,
+						previous, p_network[k - 1], p_base[k], grown);
+				added = computeMerge<MergePolicy>(allocator, emitter,
+						added, carries, p_nullLit);
+			}
+
+			previous = p_network[k];
+			grown = added.size();
+			if(added.size() > 0)
+				p_network[k] = computeMerge<MergePolicy>(allocator, emitter,
+						p_network[k], added, p_nullLit);
+		}
+	}
+
+private:
+	std::vector<int> p_base;
+	bool p_hasNullLit;
+	Literal p_nullLit;
+	SorterNetwork<Literal> p_network;
+};
+
 // produces the constraint sorter >= target
 template<typename VarAllocator, typename ClauseEmitter>
 typename ClauseEmitter::Literal computeSorterGe(VarAllocator &allocator, ClauseEmitter &emitter,
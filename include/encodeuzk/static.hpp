@@ -13,6 +13,28 @@ class StaticAllocator;
 template<typename BaseDefs>
 class StaticEmitter;
 
+// a block of consecutive variables as returned by allocateRange()
+template<typename Variable>
+class VariableRange {
+public:
+	typedef typename Variable::Literal Literal;
+
+	VariableRange() : p_first(Variable::illegalVar()), p_size(0) { }
+	VariableRange(Variable first, size_t size) : p_first(first), p_size(size) { }
+
+	size_t size() const {
+		return p_size;
+	}
+
+	Variable operator[] (size_t i) const {
+		return Variable::fromIndex(p_first.getIndex() + i);
+	}
+
+private:
+	Variable p_first;
+	size_t p_size;
+};
+
 template<typename BaseDefs>
 class StaticVariable {
 public:
@@ -114,7 +136,7 @@ struct StaticDefs {
 };
 
 template<typename BaseDefs>
-class StaticAllocator {
+class StaticAllocator final {
 public:
 	typedef StaticDefs<BaseDefs> Defs;
 	typedef typename Defs::Variable Variable;
@@ -122,7 +144,8 @@ public:
 
 	StaticAllocator(StaticFormula<BaseDefs> &formula);
 
-	virtual Variable allocate();
+	Variable allocate();
+	VariableRange<Variable> allocateRange(size_t n);
 
 private:
 	StaticFormula<BaseDefs> &p_formula;
@@ -139,6 +162,11 @@ public:
 
 	template<typename Iterator>
 	void emit(Iterator begin, Iterator end);
+	void emitBlock(const Literal *literals, const unsigned int *sizes, size_t num_clauses);
+
+	// emits the constraint xor(begin, ..., end) = rhs as a native XOR clause
+	template<typename Iterator>
+	void emitXor(Iterator begin, Iterator end, bool rhs);
 private:
 	StaticFormula<BaseDefs> &p_formula;
 };
@@ -146,6 +174,9 @@ private:
 template<typename BaseDefs>
 std::ostream &operator<< (std::ostream &stream, const StaticFormula<BaseDefs> &formula);
 
+template<typename BaseDefs>
+int64_t simplifyFormula(StaticFormula<BaseDefs> &formula, bool subsumption);
+
 template<typename BaseDefs>
 class StaticFormula {
 public:
@@ -158,13 +189,37 @@ public:
 	friend class StaticAllocator<BaseDefs>;
 	friend class StaticEmitter<BaseDefs>;
 	friend std::ostream &operator<< <> (std::ostream &stream, const StaticFormula<BaseDefs> &formula);
+	friend int64_t simplifyFormula<> (StaticFormula<BaseDefs> &formula, bool subsumption);
 
 	StaticFormula();
 
+	int64_t numVariables() const {
+		return p_numVariables;
+	}
+	int64_t numClauses() const {
+		return p_numClauses;
+	}
+	// the literals of all clauses in DIMACS numbering; each clause ends with 0
+	const std::vector<int> &clauses() const {
+		return p_clauses;
+	}
+
+	// XOR clauses are stored separately in the same format; the first literal
+	// is negated if the right hand side is false. simplifyFormula() and
+	// StaticPropagator only consider the ordinary clauses
+	int64_t numXorClauses() const {
+		return p_numXorClauses;
+	}
+	const std::vector<int> &xorClauses() const {
+		return p_xorClauses;
+	}
+
 private:
-	int p_numVariables;
-	int p_numClauses;
+	int64_t p_numVariables;
+	int64_t p_numClauses;
+	int64_t p_numXorClauses;
 	std::vector<int> p_clauses;
+	std::vector<int> p_xorClauses;
 };
 
 }; // namespace encodeuzk
@@ -16,10 +16,23 @@ StaticAllocator<BaseDefs>::StaticAllocator(StaticFormula<BaseDefs> &formula)
 
 template<typename BaseDefs>
 typename StaticDefs<BaseDefs>::Variable StaticAllocator<BaseDefs>::allocate() {
+	// the clauses store DIMACS numbers as int
+	if(p_formula.p_numVariables >= std::numeric_limits<int>::max())
+		throw std::overflow_error("Too many variables for StaticFormula");
 	p_formula.p_numVariables++;
 	return Variable::fromNumber(p_formula.p_numVariables);
 }
 
+template<typename BaseDefs>
+VariableRange<typename StaticDefs<BaseDefs>::Variable>
+StaticAllocator<BaseDefs>::allocateRange(size_t n) {
+	if(n > (uint64_t)(std::numeric_limits<int>::max() - p_formula.p_numVariables))
+		throw std::overflow_error("Too many variables for StaticFormula");
+	Variable first = Variable::fromNumber(p_formula.p_numVariables + 1);
+	p_formula.p_numVariables += n;
+	return VariableRange<Variable>(first, n);
+}
+
 template<typename BaseDefs>
 StaticEmitter<BaseDefs>::StaticEmitter(StaticFormula<BaseDefs> &formula)
 		: p_formula(formula) { }
@@ -33,9 +46,38 @@ void StaticEmitter<BaseDefs>::emit(Iterator begin, Iterator end) {
 	p_formula.p_numClauses++;
 }
 
+template<typename BaseDefs>
+void StaticEmitter<BaseDefs>::emitBlock(const Literal *literals,
+		const unsigned int *sizes, size_t num_clauses) {
+	std::vector<int> &clauses = p_formula.p_clauses;
+	size_t needed = clauses.size() + num_clauses
+			+ std::accumulate(sizes, sizes + num_clauses, size_t(0));
+	if(needed > clauses.capacity())
+		clauses.reserve(std::max(needed, 2 * clauses.capacity()));
+
+	for(size_t i = 0; i < num_clauses; i++) {
+		for(unsigned int k = 0; k < sizes[i]; k++)
+			clauses.push_back((literals++)->toNumber());
+		clauses.push_back(0);
+	}
+	p_formula.p_numClauses += num_clauses;
+}
+
+template<typename BaseDefs>
+template<typename Iterator>
+void StaticEmitter<BaseDefs>::emitXor(Iterator begin, Iterator end, bool rhs) {
+	for(auto it = begin; it != end; ++it) {
+		int number = it->toNumber();
+		p_formula.p_xorClauses.push_back(!rhs && it == begin ? -number : number);
+	}
+	p_formula.p_xorClauses.push_back(0);
+	p_formula.p_numXorClauses++;
+}
+
 template<typename BaseDefs>
 std::ostream &operator<< (std::ostream &stream, const StaticFormula<BaseDefs> &formula) {
-	stream << "p cnf " << formula.p_numVariables << " " << formula.p_numClauses << std::endl;
+	stream << "p cnf " << formula.p_numVariables << " "
+			<< (formula.p_numClauses + formula.p_numXorClauses) << std::endl;
 	bool first_literal = true;
 	for(auto it = formula.p_clauses.begin(); it != formula.p_clauses.end(); ++it) {
 		if(!first_literal)
@@ -48,11 +90,27 @@ std::ostream &operator<< (std::ostream &stream, const StaticFormula<BaseDefs> &f
 			first_literal = false;
 		}
 	}
+	// XOR clauses use the extended DIMACS format of CryptoMiniSat
+	first_literal = true;
+	for(auto it = formula.p_xorClauses.begin(); it != formula.p_xorClauses.end(); ++it) {
+		if(first_literal)
+			stream << 'x';
+		else
+			stream << ' ';
+		if(*it == 0) {
+			stream << '0' << std::endl;
+			first_literal = true;
+		}else{
+			stream << *it;
+			first_literal = false;
+		}
+	}
+	return stream;
 }
 
 template<typename BaseDefs>
 StaticFormula<BaseDefs>::StaticFormula()
-		: p_numVariables(0), p_numClauses(0) { }
+		: p_numVariables(0), p_numClauses(0), p_numXorClauses(0) { }
 
 } // namespace encodeuzk
 
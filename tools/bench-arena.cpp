@@ -0,0 +1,65 @@
+// builds a pairwise sorter over n inputs (100000 by default, about 45M
+// clauses) into a StaticFormula or an ArenaFormula and reports the resident
+// memory. each run measures one store since the peak is per process.
+// with ENCODEUZK_ARENA_MMAP the arena can spill to a directory.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/bench-arena.cpp -o bench-arena
+//   g++ -std=c++11 -O2 -DENCODEUZK_ARENA_MMAP -Iinclude tools/bench-arena.cpp -o bench-arena-mmap
+//   ./bench-arena static|arena [n]
+//   ./bench-arena-mmap arena [n] [spill directory]
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+template<typename Formula>
+void buildFormula(Formula &formula, size_t n) {
+	typename Formula::VarAllocator allocator(formula);
+	typename Formula::ClauseEmitter emitter(formula);
+
+	std::vector<typename Formula::Literal> lits;
+	for(size_t i = 0; i < n; i++)
+		lits.push_back(allocator.allocate().oneLiteral());
+	typename Formula::Literal null_lit = allocator.allocate().oneLiteral();
+	forceFalse(allocator, emitter, null_lit);
+
+	computePwSort(allocator, emitter, lits, null_lit);
+}
+
+// prints the VmRSS and VmHWM lines of /proc/self/status
+void printMemory() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while(std::getline(status, line))
+		if(line.compare(0, 5, "VmRSS") == 0 || line.compare(0, 5, "VmHWM") == 0)
+			std::cout << line << std::endl;
+}
+
+int main(int argc, char **argv) {
+	std::string mode = argc > 1 ? argv[1] : "arena";
+	size_t n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+
+	auto start = std::chrono::steady_clock::now();
+	if(mode == "static") {
+		StaticFormula<ToolDefs> formula;
+		buildFormula(formula, n);
+		std::cout << "static: " << formula.numClauses() << " clauses in "
+				<< secondsSince(start) << "s" << std::endl;
+		printMemory();
+	}else if(mode == "arena") {
+		// 1M literal indices per chunk; a multiple of the page size
+		ArenaFormula<ToolDefs> formula;
+#ifdef ENCODEUZK_ARENA_MMAP
+		if(argc > 3)
+			formula.spillTo(argv[3]);
+#endif
+		buildFormula(formula, n);
+		std::cout << "arena: " << formula.numClauses() << " clauses in "
+				<< secondsSince(start) << "s" << std::endl;
+		printMemory();
+	}else{
+		std::cerr << "Usage: " << argv[0] << " static|arena [n] [spill directory]" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,87 @@
+// measures unit propagation on cardinality constraints (forceAtLeastPw) and
+// on weighted constraints (computeSorterNetwork and computeSorterNetworkGe)
+// for each merge policy, and checks the propagation for generalized arc
+// consistency. the results are written to std::cerr, because
+// computeSorterNetwork reports the sizes of its sorters on std::cout.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/bench-propagation.cpp -o bench-propagation
+//   ./bench-propagation [rounds] > /dev/null
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+void printStats(const std::string &name, const StaticFormula<ToolDefs> &formula,
+		const PropagationStats &stats) {
+	std::cerr << name << ": " << formula.numClauses() << " clauses, "
+			<< stats.decisions << " decisions, "
+			<< stats.propagationsPerSecond() << " props/s, "
+			<< stats.missedImplications << " missed implications, "
+			<< stats.missedConflicts << " missed conflicts, "
+			<< stats.wrongConflicts << " wrong conflicts" << std::endl;
+}
+
+// sum lits >= rhs
+template<typename MergePolicy>
+PropagationStats benchCardinality(const std::string &name, size_t n, int rhs,
+		uint64_t rounds) {
+	StaticFormula<ToolDefs> formula;
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+
+	std::vector<StaticLiteral<ToolDefs>> lits;
+	for(size_t i = 0; i < n; i++)
+		lits.push_back(allocator.allocate().oneLiteral());
+	StaticLiteral<ToolDefs> null_lit = allocator.allocate().oneLiteral();
+	forceFalse(allocator, emitter, null_lit);
+	forceAtLeastPw<MergePolicy>(allocator, emitter, lits, rhs, null_lit);
+
+	PropagationStats stats = benchmarkPropagation(formula, lits,
+			std::vector<int64_t>(n, 1), int64_t(rhs), rounds, 1);
+	printStats(name, formula, stats);
+	return stats;
+}
+
+// sum weights[i] * lits[i] >= rhs
+template<typename MergePolicy>
+PropagationStats benchSorterNetwork(const std::string &name,
+		const std::vector<int64_t> &weights, int64_t rhs, uint64_t rounds) {
+	StaticFormula<ToolDefs> formula;
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+
+	std::vector<StaticLiteral<ToolDefs>> lits;
+	for(size_t i = 0; i < weights.size(); i++)
+		lits.push_back(allocator.allocate().oneLiteral());
+	std::vector<int> base = optimalBase(weights);
+	SorterNetwork<StaticLiteral<ToolDefs>> network
+			= computeSorterNetwork<MergePolicy>(allocator, emitter, lits, weights, base);
+	forceTrue(allocator, emitter, computeSorterNetworkGe(allocator, emitter,
+			network, base, convertBase(rhs, base)));
+
+	PropagationStats stats = benchmarkPropagation(formula, lits, weights, rhs, rounds, 1);
+	printStats(name, formula, stats);
+	return stats;
+}
+
+int main(int argc, char **argv) {
+	uint64_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+	uint64_t wrong = 0;
+	wrong += benchCardinality<PairwiseMergePolicy>("forceAtLeastPw, pairwise", 60, 30, rounds).wrongConflicts;
+	wrong += benchCardinality<DirectMergePolicy>("forceAtLeastPw, direct", 60, 30, rounds).wrongConflicts;
+	wrong += benchCardinality<BitonicMergePolicy>("forceAtLeastPw, bitonic", 60, 30, rounds).wrongConflicts;
+	wrong += benchCardinality<HybridMergePolicy<8>>("forceAtLeastPw, hybrid", 60, 30, rounds).wrongConflicts;
+
+	std::mt19937_64 generator(7);
+	std::vector<int64_t> weights;
+	for(int i = 0; i < 30; i++)
+		weights.push_back(1 + generator() % 50);
+	int64_t rhs = std::accumulate(weights.begin(), weights.end(), int64_t(0)) / 2;
+
+	wrong += benchSorterNetwork<PairwiseMergePolicy>("computeSorterNetwork, pairwise", weights, rhs, rounds).wrongConflicts;
+	wrong += benchSorterNetwork<DirectMergePolicy>("computeSorterNetwork, direct", weights, rhs, rounds).wrongConflicts;
+	wrong += benchSorterNetwork<BitonicMergePolicy>("computeSorterNetwork, bitonic", weights, rhs, rounds).wrongConflicts;
+	wrong += benchSorterNetwork<HybridMergePolicy<8>>("computeSorterNetwork, hybrid", weights, rhs, rounds).wrongConflicts;
+	return wrong ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+// measures simplifyFormula() on a pairwise sorter over n inputs
+// (100000 by default, about 45M clauses) with some overlapping
+// at-most-one constraints that produce duplicate clauses.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/bench-simplify.cpp -o bench-simplify
+//   ./bench-simplify [n]
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+void buildFormula(StaticFormula<ToolDefs> &formula, size_t n) {
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+
+	std::vector<StaticLiteral<ToolDefs>> lits;
+	for(size_t i = 0; i < n; i++)
+		lits.push_back(allocator.allocate().oneLiteral());
+	StaticLiteral<ToolDefs> null_lit = allocator.allocate().oneLiteral();
+	forceFalse(allocator, emitter, null_lit);
+
+	computePwSort(allocator, emitter, lits, null_lit);
+	for(size_t i = 0; i + 30 <= n && i < 2000; i += 10)
+		forceAtMostOne(allocator, emitter, std::vector<StaticLiteral<ToolDefs>>(
+				lits.begin() + i, lits.begin() + i + 30));
+}
+
+int main(int argc, char **argv) {
+	size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+	for(int subsumption = 0; subsumption < 2; subsumption++) {
+		StaticFormula<ToolDefs> formula;
+		buildFormula(formula, n);
+		int64_t clauses = formula.numClauses();
+
+		auto start = std::chrono::steady_clock::now();
+		int64_t removed = simplifyFormula(formula, subsumption);
+		std::cout << (subsumption ? "deduplication and subsumption: " : "deduplication: ")
+				<< clauses << " clauses, " << removed << " removed in "
+				<< secondsSince(start) << "s" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,51 @@
+// includes the whole library for the programs in this directory
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef ENCODEUZK_ARENA_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "encodeuzk/encode.hpp"
+#include "encodeuzk/static.hpp"
+#include "encodeuzk/arena.hpp"
+#include "encodeuzk/circuit.hpp"
+#include "encodeuzk/encode.inline.hpp"
+#include "encodeuzk/static.inline.hpp"
+#include "encodeuzk/arena.inline.hpp"
+#include "encodeuzk/circuit.inline.hpp"
+#include "encodeuzk/simplify.inline.hpp"
+#include "encodeuzk/basic.inline.hpp"
+#include "encodeuzk/mixed-radix.inline.hpp"
+#include "encodeuzk/sorting.inline.hpp"
+#include "encodeuzk/simulate.inline.hpp"
+#include "encodeuzk/propagate.inline.hpp"
+
+struct ToolDefs {
+	typedef int64_t LiteralIndex;
+};
+
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,79 @@
+// compares the size of computeSorterNetwork with the construction that
+// replicates each literal digit-many times, and validates
+// computeSorterNetworkGe on random weights, bases and right hand sides.
+// the results are written to std::cerr, because computeSorterNetwork
+// reports the sizes of its sorters on std::cout.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/sorter-network.cpp -o sorter-network
+//   ./sorter-network > /dev/null
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+// the digit sorters of computeSorterNetwork before computeWeightedSort
+template<typename VarAllocator, typename ClauseEmitter, typename Weight>
+void computeReplicatedSorterNetwork(VarAllocator &allocator, ClauseEmitter &emitter,
+		const std::vector<typename ClauseEmitter::Literal> &lits,
+		const std::vector<Weight> &weights, const std::vector<int> &base) {
+	typename ClauseEmitter::Literal null_lit = allocator.allocate().oneLiteral();
+	emit(emitter, { null_lit.inverse() });
+
+	SorterNetwork<typename ClauseEmitter::Literal> sorters;
+	for(size_t k = 0; k < base.size(); k++) {
+		std::vector<typename ClauseEmitter::Literal> ins;
+		if(k > 0) {
+			for(size_t j = base[k] - 1; j < sorters.back().size(); j += base[k])
+				ins.push_back(sorters.back()[j]);
+		}
+		for(size_t i = 0; i < lits.size(); i++) {
+			std::vector<int> digits = convertBase(weights[i], base);
+			for(int j = 0; j < digits[k]; j++)
+				ins.push_back(lits[i]);
+		}
+		sorters.push_back(computePwSort(allocator, emitter, ins, null_lit));
+	}
+}
+
+int main() {
+	std::mt19937_64 generator(5);
+
+	std::vector<int64_t> weights;
+	for(int i = 0; i < 200; i++)
+		weights.push_back(1 + generator() % 1000);
+	std::vector<int> base = optimalBase(weights);
+
+	for(int replicated = 0; replicated < 2; replicated++) {
+		StaticFormula<ToolDefs> formula;
+		StaticAllocator<ToolDefs> allocator(formula);
+		StaticEmitter<ToolDefs> emitter(formula);
+		std::vector<StaticLiteral<ToolDefs>> lits;
+		for(size_t i = 0; i < weights.size(); i++)
+			lits.push_back(allocator.allocate().oneLiteral());
+
+		if(replicated) {
+			computeReplicatedSorterNetwork(allocator, emitter, lits, weights, base);
+		}else{
+			computeSorterNetwork(allocator, emitter, lits, weights, base);
+		}
+		std::cerr << (replicated ? "replicated literals: " : "computeSorterNetwork: ")
+				<< formula.numVariables() << " variables, "
+				<< formula.numClauses() << " clauses" << std::endl;
+	}
+
+	uint64_t failures = 0;
+	for(int t = 0; t < 200; t++) {
+		size_t n = 1 + generator() % 12;
+		std::vector<int64_t> small_weights;
+		for(size_t i = 0; i < n; i++)
+			small_weights.push_back(1 + generator() % 40);
+		std::vector<int> small_base(1, 1);
+		int digits = 1 + generator() % 3;
+		for(int i = 0; i < digits; i++)
+			small_base.push_back(2 + generator() % 4);
+		int64_t rhs = generator() % 200;
+		failures += validateSorterNetworkGe<ToolDefs>(small_weights, small_base, rhs, 64, t);
+	}
+	std::cerr << "200 random constraints: " << failures << " failures" << std::endl;
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+// validates IncrementalSorterNetwork with CircuitSimulator. for 60 random
+// bases, literals are added in random batches; after each batch a few
+// comparison literals are produced with computeSorterNetworkGe. every
+// comparison literal, including the ones for earlier batches, has to match
+// the weighted sum of the literals that were added up to then on all
+// assignments. it also compares the clauses that adding one literal to a
+// network over 399 literals costs with those of a network over all 400.
+// the results are written to std::cerr, because the sorter builders report
+// their sizes on std::cout.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/validate-incremental.cpp -o validate-incremental
+//   ./validate-incremental > /dev/null
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+typedef StaticLiteral<ToolDefs> Literal;
+
+struct Comparison {
+	// the comparison covers the first num_lits literals
+	size_t num_lits;
+	int64_t rhs;
+	Literal ge;
+};
+
+// clauses of a network over 400 literals, and clauses that extending a
+// network over the first 399 literals by the last one costs
+void compareExtension(std::mt19937_64 &generator) {
+	std::vector<int64_t> weights;
+	for(int i = 0; i < 400; i++)
+		weights.push_back(1 + generator() % 1000);
+	std::vector<int> base = optimalBase(weights);
+
+	StaticFormula<ToolDefs> formula;
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+	std::vector<Literal> lits;
+	for(size_t i = 0; i < weights.size(); i++)
+		lits.push_back(allocator.allocate().oneLiteral());
+	computeSorterNetwork(allocator, emitter, lits, weights, base);
+	int64_t rebuild = formula.numClauses();
+
+	StaticFormula<ToolDefs> incremental;
+	StaticAllocator<ToolDefs> incremental_allocator(incremental);
+	StaticEmitter<ToolDefs> incremental_emitter(incremental);
+	IncrementalSorterNetwork<Literal> network(base);
+	network.extend(incremental_allocator, incremental_emitter,
+			std::vector<Literal>(lits.begin(), lits.end() - 1),
+			std::vector<int64_t>(weights.begin(), weights.end() - 1));
+	int64_t before = incremental.numClauses();
+	network.extend(incremental_allocator, incremental_emitter,
+			std::vector<Literal>(1, lits.back()),
+			std::vector<int64_t>(1, weights.back()));
+
+	std::cerr << "400 literals: " << rebuild << " clauses for the network, "
+			<< incremental.numClauses() - before
+			<< " clauses for adding the last one to the other 399" << std::endl;
+}
+
+int main() {
+	std::mt19937_64 generator(11);
+	compareExtension(generator);
+
+	uint64_t failures = 0;
+	for(int t = 0; t < 60; t++) {
+		Circuit<ToolDefs> circuit;
+		CircuitAllocator<ToolDefs> allocator(circuit);
+		CircuitEmitter<ToolDefs> emitter(circuit);
+
+		std::vector<int> base(1, 1);
+		int digits = 1 + generator() % 3;
+		for(int i = 0; i < digits; i++)
+			base.push_back(2 + generator() % 4);
+		IncrementalSorterNetwork<Literal> network(base);
+
+		std::vector<Literal> lits;
+		std::vector<int64_t> weights;
+		std::vector<Comparison> comparisons;
+		int batches = 1 + generator() % 4;
+		for(int b = 0; b < batches; b++) {
+			std::vector<Literal> batch_lits;
+			std::vector<int64_t> batch_weights;
+			int n = generator() % 4;
+			for(int i = 0; i < n; i++) {
+				batch_lits.push_back(circuit.addInput().oneLiteral());
+				batch_weights.push_back(1 + generator() % 30);
+			}
+			network.extend(allocator, emitter, batch_lits, batch_weights);
+			lits.insert(lits.end(), batch_lits.begin(), batch_lits.end());
+			weights.insert(weights.end(), batch_weights.begin(), batch_weights.end());
+
+			for(int r = 0; r < 3; r++) {
+				Comparison comparison;
+				comparison.num_lits = lits.size();
+				comparison.rhs = generator() % 120;
+				comparison.ge = computeSorterNetworkGe(allocator, emitter,
+						network.network(), base, convertBase(comparison.rhs, base));
+				comparisons.push_back(comparison);
+			}
+		}
+
+		// at most 12 literals, so all assignments are enumerated
+		CircuitSimulator<ToolDefs> simulator(circuit);
+		std::vector<uint64_t> words(lits.size());
+		for(uint64_t round = 0; round < 64; round++) {
+			uint64_t mask = simulationRound(words, round, 64, generator);
+			if(!mask)
+				break;
+			for(size_t i = 0; i < lits.size(); i++)
+				simulator.setInput(lits[i].variable(), words[i]);
+			simulator.simulate();
+
+			uint64_t wrong = ~simulator.satisfied();
+			for(auto it = comparisons.begin(); it != comparisons.end(); ++it) {
+				for(uint64_t lane = 0; lane < 64; lane++) {
+					int64_t sum = 0;
+					for(size_t i = 0; i < it->num_lits; i++)
+						if((words[i] >> lane) & 1)
+							sum += weights[i];
+					if(((simulator.value(it->ge) >> lane) & 1) != (sum >= it->rhs))
+						wrong |= uint64_t(1) << lane;
+				}
+			}
+			failures += popCount(wrong & mask);
+		}
+	}
+	std::cerr << "60 random networks: " << failures << " failures" << std::endl;
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// checks computePwSort and computeMerge exhaustively on the clause level for
+// every merge policy: the encodings are built into a StaticFormula and
+// StaticPropagator assigns all inputs. the outputs of these encodings are
+// fully propagated once all inputs are assigned, so every output has to
+// be assigned to whether enough inputs are true. computePwSort receives
+// up to 12 inputs, computeMerge two sorted sequences of up to 8 inputs each.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/validate-merge.cpp -o validate-merge
+//   ./validate-merge
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+typedef StaticLiteral<ToolDefs> Literal;
+
+// assumes the inputs, whose values are given by the bits of assignment, and
+// checks that output k is assigned to whether at least k + 1 inputs are true
+uint64_t checkOutputs(const StaticFormula<ToolDefs> &formula,
+		const std::vector<Literal> &ins, const std::vector<Literal> &outs,
+		uint64_t assignment) {
+	StaticPropagator<ToolDefs> propagator(formula);
+	if(propagator.inconsistent())
+		return 1;
+	for(size_t i = 0; i < ins.size(); i++)
+		if(!propagator.assume((assignment >> i) & 1 ? ins[i] : ins[i].inverse()))
+			return 1;
+
+	size_t count = popCount(assignment);
+	for(size_t k = 0; k < outs.size(); k++)
+		if(propagator.value(outs[k]) != (k < count ? 1 : -1))
+			return 1;
+	return 0;
+}
+
+template<typename MergePolicy>
+uint64_t validateSort(size_t n) {
+	StaticFormula<ToolDefs> formula;
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+	Literal null_lit = allocator.allocate().oneLiteral();
+	forceFalse(allocator, emitter, null_lit);
+
+	std::vector<Literal> ins;
+	for(size_t i = 0; i < n; i++)
+		ins.push_back(allocator.allocate().oneLiteral());
+	std::vector<Literal> outs
+			= computePwSort<MergePolicy>(allocator, emitter, ins, null_lit);
+	if(outs.size() != n)
+		return 1;
+
+	uint64_t failures = 0;
+	for(uint64_t assignment = 0; assignment < (uint64_t(1) << n); assignment++)
+		failures += checkOutputs(formula, ins, outs, assignment);
+	return failures;
+}
+
+// merges sorted sequences of p and q literals; the inputs are only
+// assigned to sorted values, i.e. to all pairs of counts
+template<typename MergePolicy>
+uint64_t validateMerge(size_t p, size_t q) {
+	StaticFormula<ToolDefs> formula;
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+	Literal null_lit = allocator.allocate().oneLiteral();
+	forceFalse(allocator, emitter, null_lit);
+
+	std::vector<Literal> a;
+	for(size_t i = 0; i < p; i++)
+		a.push_back(allocator.allocate().oneLiteral());
+	std::vector<Literal> b;
+	for(size_t i = 0; i < q; i++)
+		b.push_back(allocator.allocate().oneLiteral());
+	std::vector<Literal> outs
+			= computeMerge<MergePolicy>(allocator, emitter, a, b, null_lit);
+	if(outs.size() != p + q)
+		return 1;
+
+	std::vector<Literal> ins(a);
+	ins.insert(ins.end(), b.begin(), b.end());
+	uint64_t failures = 0;
+	for(size_t i = 0; i <= p; i++)
+		for(size_t j = 0; j <= q; j++)
+			failures += checkOutputs(formula, ins, outs,
+					((uint64_t(1) << i) - 1) | (((uint64_t(1) << j) - 1) << p));
+	return failures;
+}
+
+template<typename MergePolicy>
+uint64_t validatePolicy(const std::string &name) {
+	uint64_t failures = 0;
+	for(size_t n = 0; n <= 12; n++)
+		failures += validateSort<MergePolicy>(n);
+	for(size_t p = 0; p <= 8; p++)
+		for(size_t q = 0; q <= 8; q++)
+			failures += validateMerge<MergePolicy>(p, q);
+	std::cout << name << ": " << failures << " failures" << std::endl;
+	return failures;
+}
+
+int main() {
+	uint64_t failures = 0;
+	failures += validatePolicy<PairwiseMergePolicy>("pairwise");
+	failures += validatePolicy<DirectMergePolicy>("direct");
+	failures += validatePolicy<BitonicMergePolicy>("bitonic");
+	failures += validatePolicy<HybridMergePolicy<2>>("hybrid, threshold 2");
+	failures += validatePolicy<HybridMergePolicy<4>>("hybrid, threshold 4");
+	return failures ? 1 : 0;
+}
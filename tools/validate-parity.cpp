@@ -0,0 +1,90 @@
+// checks the parity encoders exhaustively for up to 11 literals and cut
+// lengths 3 to 6: forceXorN for both right hand sides, the generic
+// computeParityN and the circuit computeParityN through lowerCircuit.
+// once all literals are assigned, unit propagation assigns every auxiliary
+// variable of these tree encodings, so StaticPropagator decides whether an
+// assignment satisfies the formula.
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/validate-parity.cpp -o validate-parity
+//   ./validate-parity
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+typedef StaticLiteral<ToolDefs> Literal;
+
+enum class ParityMode {
+	XorTrue,
+	XorFalse,
+	Parity,
+	CircuitParity
+};
+
+void buildParity(StaticFormula<ToolDefs> &formula, const std::vector<Literal> &lits,
+		ParityMode mode, int cut) {
+	StaticAllocator<ToolDefs> allocator(formula);
+	StaticEmitter<ToolDefs> emitter(formula);
+	switch(mode) {
+	case ParityMode::XorTrue:
+		forceXorN(allocator, emitter, lits, true, cut);
+		break;
+	case ParityMode::XorFalse:
+		forceXorN(allocator, emitter, lits, false, cut);
+		break;
+	case ParityMode::Parity:
+		forceTrue(allocator, emitter, computeParityN(allocator, emitter, lits, cut));
+		break;
+	case ParityMode::CircuitParity: {
+		Circuit<ToolDefs> circuit;
+		CircuitAllocator<ToolDefs> circuit_allocator(circuit);
+		CircuitEmitter<ToolDefs> circuit_emitter(circuit);
+		std::vector<Literal> ins;
+		for(size_t i = 0; i < lits.size(); i++)
+			ins.push_back(circuit.addInput().oneLiteral());
+		forceTrue(circuit_allocator, circuit_emitter,
+				computeParityN(circuit_allocator, circuit_emitter, ins, cut));
+
+		std::vector<Literal> mapping(circuit.numVariables(), Literal::illegalLit());
+		for(size_t i = 0; i < lits.size(); i++)
+			mapping[ins[i].variable().getIndex()] = lits[i];
+		lowerCircuit(circuit, allocator, emitter, mapping);
+		break;
+	}
+	}
+}
+
+int main() {
+	const ParityMode modes[] = { ParityMode::XorTrue, ParityMode::XorFalse,
+			ParityMode::Parity, ParityMode::CircuitParity };
+
+	uint64_t failures = 0;
+	for(size_t n = 0; n <= 11; n++) {
+		for(int cut = 3; cut <= 6; cut++) {
+			for(ParityMode mode : modes) {
+				StaticFormula<ToolDefs> formula;
+				StaticAllocator<ToolDefs> allocator(formula);
+				std::vector<Literal> lits;
+				for(size_t i = 0; i < n; i++)
+					lits.push_back(allocator.allocate().oneLiteral());
+				buildParity(formula, lits, mode, cut);
+
+				StaticPropagator<ToolDefs> propagator(formula);
+				for(uint64_t assignment = 0; assignment < (uint64_t(1) << n); assignment++) {
+					bool consistent = !propagator.inconsistent();
+					for(size_t i = 0; i < n && consistent; i++)
+						consistent = propagator.assume((assignment >> i) & 1
+								? lits[i] : lits[i].inverse());
+					propagator.backtrack(0);
+
+					bool parity = popCount(assignment) % 2 == 1;
+					bool expected = mode == ParityMode::XorFalse ? !parity : parity;
+					if(consistent != expected)
+						failures++;
+				}
+			}
+		}
+	}
+	std::cout << "exhaustive, up to 11 literals: " << failures << " failures" << std::endl;
+	return failures ? 1 : 0;
+}
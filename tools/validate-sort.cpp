@@ -0,0 +1,24 @@
+// validates computePwSort with CircuitSimulator: exhaustively for up to
+// 12 inputs, and on 256 random assignments for n inputs (5000 by default).
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/validate-sort.cpp -o validate-sort
+//   ./validate-sort [n]
+
+#include "common.hpp"
+
+using namespace encodeuzk;
+
+int main(int argc, char **argv) {
+	size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+
+	uint64_t failures = 0;
+	for(size_t k = 0; k <= 12; k++)
+		failures += validatePwSort<ToolDefs>(k, 64, 1);
+	std::cout << "exhaustive, up to 12 inputs: " << failures << " failures" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	uint64_t random_failures = validatePwSort<ToolDefs>(n, 4, 7);
+	std::cout << n << " inputs, 256 random assignments: " << random_failures
+			<< " failures in " << secondsSince(start) << "s" << std::endl;
+	return failures + random_failures ? 1 : 0;
+}